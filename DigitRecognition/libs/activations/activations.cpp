@@ -1,5 +1,8 @@
 #define _USE_MATH_DEFINES  // For M_PI on Windows
 #include "activations.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 #include <unordered_map>
@@ -30,6 +33,103 @@ double relu_derivative(double x) {
     return x > 0 ? 1.0 : 0.0;
 }
 
+// sigmoid'(x) = s(1 - s) with s = sigmoid(x), the same product sigmoid_derivative forms
+double sigmoid_derivative_from_output(double y) {
+    return y * (1.0 - y);
+}
+
+// relu(x) > 0 exactly when x > 0
+double relu_derivative_from_output(double y) {
+    return y > 0 ? 1.0 : 0.0;
+}
+
+
+namespace {
+
+    //
+    // sigmoid(x) at x = i / 32 for x in [0, 20], with the slope scaled by the step so each
+    // interval is a cubic Hermite segment. Interpolation error is around 1e-10, past the end
+    // sigmoid(20) stands in for sigmoid(x), off by at most 2.1e-9. 10 KB, small enough to stay
+    // in L1 next to the weights.
+    //
+    constexpr double table_end = 20.0;
+    constexpr int table_steps_per_unit = 32;
+    constexpr int table_intervals = static_cast<int>(table_end) * table_steps_per_unit;
+
+    struct TableNode {
+        double value;   // sigmoid(x)
+        double slope;   // sigmoid'(x) × step
+    };
+
+    const std::array<TableNode, table_intervals + 1> sigmoid_nodes = [] {
+        std::array<TableNode, table_intervals + 1> nodes{};
+        for (int i = 0; i <= table_intervals; ++i) {
+            const double s = sigmoid(static_cast<double>(i) / table_steps_per_unit);
+            nodes[i] = {s, s * (1.0 - s) / table_steps_per_unit};
+        }
+        return nodes;
+    }();
+
+    // e^x as 2^n × e^r with |r| <= ln2 / 2, e^r from its Taylor series to r^6 (relative error below 1.3e-7)
+    double exp_polynomial(double x) {
+        constexpr double log2e = 1.4426950408889634;
+        constexpr double ln2 = 0.6931471805599453;
+        constexpr double round_shift = 6755399441055744.0;    // 1.5 × 2^52, adding it rounds to an integer
+        if (std::isnan(x)) {
+            return x;   // NaN would pass the clamp and reach the integer conversion below
+        }
+        x = std::min(std::max(x, -708.0), 708.0);
+
+        const double n = (x * log2e + round_shift) - round_shift;
+        const double r = x - n * ln2;
+        const double p = 1.0 + r * (1.0 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 + r * (1.0 / 120 + r * (1.0 / 720))))));
+
+        // 2^n straight into the exponent bits, n is within the normal range after the clamp
+        const uint64_t bits = static_cast<uint64_t>(static_cast<int64_t>(n) + 1023) << 52;
+        double scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+        return p * scale;
+    }
+
+}
+
+double sigmoid_table(double x) {
+    // NaN in, NaN out like the exact kernel, a diverging run shows up in the loss
+    if (std::isnan(x)) {
+        return x;
+    }
+
+    // Past the end the last segment is held at its end point, sigmoid(20), no branch on the range.
+    // The constant goes first so std::min would also hand back the end for a NaN, never an index from it.
+    const double position = std::min(static_cast<double>(table_intervals), std::abs(x) * table_steps_per_unit);
+    const int i = std::min(static_cast<int>(position), table_intervals - 1);
+    const double t = position - i;
+    const TableNode& left = sigmoid_nodes[i];
+    const TableNode& right = sigmoid_nodes[i + 1];
+
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    const double s = (2 * t3 - 3 * t2 + 1) * left.value + (t3 - 2 * t2 + t) * left.slope
+                   + (3 * t2 - 2 * t3) * right.value + (t3 - t2) * right.slope;
+
+    // sigmoid(-x) = 1 - sigmoid(x), by sign rather than a branch that random inputs mispredict
+    return 0.5 + std::copysign(s - 0.5, x);
+}
+
+double sigmoid_table_derivative(double x) {
+    double s = sigmoid_table(x);
+    return s * (1.0 - s);
+}
+
+double sigmoid_polynomial(double x) {
+    return 1.0 / (1.0 + exp_polynomial(-x));
+}
+
+double sigmoid_polynomial_derivative(double x) {
+    double s = sigmoid_polynomial(x);
+    return s * (1.0 - s);
+}
+
 // Factory function to get activation by name
 ActivationFunction get_activation(const std::string& name) {
     static std::unordered_map<std::string, ActivationFunction> activations_map = {
@@ -45,6 +145,40 @@ ActivationFunction get_activation(const std::string& name) {
     throw std::invalid_argument("Unknown activation function: " + name);
 }
 
+ActivationFunction get_activation(const std::string& name, ActivationKernel kernel) {
+    if (name == "sigmoid" && kernel == ActivationKernel::Table) {
+        return sigmoid_table;
+    }
+    if (name == "sigmoid" && kernel == ActivationKernel::Polynomial) {
+        return sigmoid_polynomial;
+    }
+    return get_activation(name);
+}
+
+ActivationFunction get_activation_output_derivative(const std::string& name) {
+    if (name == "sigmoid") {
+        return sigmoid_derivative_from_output;
+    }
+    if (name == "relu") {
+        return relu_derivative_from_output;
+    }
+    return {};
+}
+
+ActivationFunction get_activation_derivative(const std::string& name, ActivationKernel kernel) {
+    if (name == "relu") {
+        return relu_derivative;
+    }
+    if (name != "sigmoid") {
+        throw std::invalid_argument("Unknown activation function: " + name);
+    }
+    switch (kernel) {
+        case ActivationKernel::Table: return sigmoid_table_derivative;
+        case ActivationKernel::Polynomial: return sigmoid_polynomial_derivative;
+        default: return sigmoid_derivative;
+    }
+}
+
 
 // Apply activation function to entire vector
 std::vector<double> apply_activation(const std::vector<double>& input, 
@@ -5,6 +5,7 @@
 #include <functional>
 #include <cmath>
 #include <algorithm>
+#include <optional>
 #include <string>
 
 namespace ANN {
@@ -21,9 +22,48 @@ double relu(double x);
 double sigmoid_derivative(double x);
 double relu_derivative(double x);
 
+// The same derivatives from the activation's output y = f(x), no need to keep x or recompute f
+double sigmoid_derivative_from_output(double y);
+double relu_derivative_from_output(double y);
+
+//
+// How sigmoid is evaluated. Exact calls std::exp. Table interpolates a cubic Hermite table
+// of sigmoid over [0, 20] (absolute error below 1e-8). Polynomial builds exp from a power of
+// two and a degree 6 polynomial (absolute error below 1e-7). ReLU is the same in all three.
+//
+enum class ActivationKernel { Exact, Table, Polynomial };
+
+inline std::optional<ActivationKernel> parse_activation_kernel(const std::string& name) {
+    if (name == "exact") return ActivationKernel::Exact;
+    if (name == "table") return ActivationKernel::Table;
+    if (name == "polynomial") return ActivationKernel::Polynomial;
+    return std::nullopt;
+}
+
+inline const char* activation_kernel_name(ActivationKernel kernel) {
+    switch (kernel) {
+        case ActivationKernel::Table: return "table";
+        case ActivationKernel::Polynomial: return "polynomial";
+        default: return "exact";
+    }
+}
+
+// Approximate sigmoid and its derivative, see ActivationKernel
+double sigmoid_table(double x);
+double sigmoid_table_derivative(double x);
+double sigmoid_polynomial(double x);
+double sigmoid_polynomial_derivative(double x);
+
 // Factory function to get activation by name
 ActivationFunction get_activation(const std::string& name);
 
+// Activation and derivative by name, evaluated with kernel. Throws on an unknown name.
+ActivationFunction get_activation(const std::string& name, ActivationKernel kernel);
+ActivationFunction get_activation_derivative(const std::string& name, ActivationKernel kernel = ActivationKernel::Exact);
+
+// Derivative as a function of the output, empty for an activation whose derivative needs its input
+ActivationFunction get_activation_output_derivative(const std::string& name);
+
 // Apply activation function to entire vector
 std::vector<double> apply_activation(const std::vector<double>& input, 
                                    const ActivationFunction& func);
@@ -0,0 +1,149 @@
+#include "../activations.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+// Largest |approximate(x) - exact(x)| over a fine sweep of [-from, from] plus the far tails
+template <typename Approximate, typename Exact>
+static double max_error(Approximate approximate, Exact exact, double from) {
+    double worst = 0.0;
+    const int steps = 2000000;
+    for (int i = 0; i <= steps; ++i) {
+        const double x = -from + 2.0 * from * i / steps;
+        worst = std::max(worst, std::abs(approximate(x) - exact(x)));
+    }
+    for (double x : {-1000.0, -700.0, -40.0, 40.0, 700.0, 1000.0}) {
+        worst = std::max(worst, std::abs(approximate(x) - exact(x)));
+    }
+    return worst;
+}
+
+bool test_table_error() {
+    std::cout << "Testing table sigmoid error..." << std::endl;
+
+    const double value_error = max_error(ANN::sigmoid_table, ANN::sigmoid, 30.0);
+    const double derivative_error = max_error(ANN::sigmoid_table_derivative, ANN::sigmoid_derivative, 30.0);
+    std::cout << "  max abs error " << value_error << ", derivative " << derivative_error << std::endl;
+    ASSERT_TRUE(value_error < 1e-8);
+    ASSERT_TRUE(derivative_error < 1e-8);
+
+    // Exact at zero and symmetric, saturated within the bound
+    ASSERT_NEAR(ANN::sigmoid_table(0.0), 0.5, 1e-15);
+    ASSERT_NEAR(ANN::sigmoid_table(2.5) + ANN::sigmoid_table(-2.5), 1.0, 1e-15);
+    ASSERT_NEAR(ANN::sigmoid_table(1000.0), 1.0, 1e-8);
+    ASSERT_NEAR(ANN::sigmoid_table(-1000.0), 0.0, 1e-8);
+
+    std::cout << "✓ Table sigmoid passed" << std::endl;
+    return true;
+}
+
+bool test_polynomial_error() {
+    std::cout << "Testing polynomial sigmoid error..." << std::endl;
+
+    const double value_error = max_error(ANN::sigmoid_polynomial, ANN::sigmoid, 30.0);
+    const double derivative_error = max_error(ANN::sigmoid_polynomial_derivative, ANN::sigmoid_derivative, 30.0);
+    std::cout << "  max abs error " << value_error << ", derivative " << derivative_error << std::endl;
+    ASSERT_TRUE(value_error < 1e-7);
+    ASSERT_TRUE(derivative_error < 1e-7);
+
+    ASSERT_NEAR(ANN::sigmoid_polynomial(0.0), 0.5, 1e-15);
+    ASSERT_NEAR(ANN::sigmoid_polynomial(1000.0), 1.0, 1e-15);
+    ASSERT_NEAR(ANN::sigmoid_polynomial(-1000.0), 0.0, 1e-15);
+
+    std::cout << "✓ Polynomial sigmoid passed" << std::endl;
+    return true;
+}
+
+bool test_non_finite_inputs() {
+    std::cout << "Testing NaN and infinite inputs..." << std::endl;
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    // NaN comes back as NaN like the exact kernel, never as a table index or an exponent
+    ASSERT_TRUE(std::isnan(ANN::sigmoid(nan)));
+    ASSERT_TRUE(std::isnan(ANN::sigmoid_table(nan)));
+    ASSERT_TRUE(std::isnan(ANN::sigmoid_table(-nan)));
+    ASSERT_TRUE(std::isnan(ANN::sigmoid_table_derivative(nan)));
+    ASSERT_TRUE(std::isnan(ANN::sigmoid_polynomial(nan)));
+    ASSERT_TRUE(std::isnan(ANN::sigmoid_polynomial(-nan)));
+    ASSERT_TRUE(std::isnan(ANN::sigmoid_polynomial_derivative(nan)));
+
+    // Infinities saturate
+    ASSERT_NEAR(ANN::sigmoid_table(inf), 1.0, 1e-8);
+    ASSERT_NEAR(ANN::sigmoid_table(-inf), 0.0, 1e-8);
+    ASSERT_NEAR(ANN::sigmoid_table_derivative(inf), 0.0, 1e-8);
+    ASSERT_NEAR(ANN::sigmoid_polynomial(inf), 1.0, 1e-15);
+    ASSERT_NEAR(ANN::sigmoid_polynomial(-inf), 0.0, 1e-15);
+    ASSERT_NEAR(ANN::sigmoid_polynomial_derivative(-inf), 0.0, 1e-15);
+
+    std::cout << "✓ Non finite inputs passed" << std::endl;
+    return true;
+}
+
+bool test_kernel_selection() {
+    std::cout << "Testing kernel selection..." << std::endl;
+
+    ASSERT_TRUE(ANN::parse_activation_kernel("exact") == ANN::ActivationKernel::Exact);
+    ASSERT_TRUE(ANN::parse_activation_kernel("table") == ANN::ActivationKernel::Table);
+    ASSERT_TRUE(ANN::parse_activation_kernel("polynomial") == ANN::ActivationKernel::Polynomial);
+    ASSERT_TRUE(!ANN::parse_activation_kernel("fast"));
+    ASSERT_TRUE(std::string(ANN::activation_kernel_name(ANN::ActivationKernel::Table)) == "table");
+
+    const double x = 0.731;
+    ASSERT_TRUE(ANN::get_activation("sigmoid", ANN::ActivationKernel::Exact)(x) == ANN::sigmoid(x));
+    ASSERT_TRUE(ANN::get_activation("sigmoid", ANN::ActivationKernel::Table)(x) == ANN::sigmoid_table(x));
+    ASSERT_TRUE(ANN::get_activation("sigmoid", ANN::ActivationKernel::Polynomial)(x) == ANN::sigmoid_polynomial(x));
+    ASSERT_TRUE(ANN::get_activation_derivative("sigmoid", ANN::ActivationKernel::Table)(x) == ANN::sigmoid_table_derivative(x));
+
+    // ReLU has nothing to approximate
+    ASSERT_TRUE(ANN::get_activation("relu", ANN::ActivationKernel::Table)(-x) == 0.0);
+    ASSERT_TRUE(ANN::get_activation_derivative("relu", ANN::ActivationKernel::Polynomial)(x) == 1.0);
+
+    bool threw = false;
+    try {
+        ANN::get_activation_derivative("tanh");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    std::cout << "✓ Kernel selection passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Activation Kernel Tests" << std::endl;
+    std::cout << "===============================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_table_error();
+    all_passed &= test_polynomial_error();
+    all_passed &= test_non_finite_inputs();
+    all_passed &= test_kernel_selection();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -16,103 +16,280 @@ void Config::load_from_file(const std::string& config_file) {
         nlohmann::json config_json;
         file >> config_json;
 
-        // Parse network configuration
-        if (config_json.contains("network")) {
-            auto net = config_json["network"];
-            network.layers = net.value("layers", std::vector<int>{784, 128, 64, 10});
-            network.activation = net.value("activation", "sigmoid");
-            // Parse weight initialization
-            if (net.contains("weight_init")) {
-                auto weight_init = net["weight_init"];
-                network.weight_init.method = weight_init.value("method", "uniform");
-                network.weight_init.range = weight_init.value("range", std::vector<double>{-1.0, 1.0});
-            } else {
-                network.weight_init.method = "uniform";
-                network.weight_init.range = {-1.0, 1.0};
-            }
-        }
+        load_from_json(config_json);
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading config: " << e.what() << std::endl;
+        load_defaults();
+    }
+}
 
-        // Parse training configuration
-        if (config_json.contains("training")) {
-            auto train = config_json["training"];
-            training.epochs = train.value("epochs", 5);
-            training.shuffle = train.value("shuffle", true);
-            training.data_path = train.value("data_path", "./data/mnist_images/");
-            // Parse learning rate schedule
-            if (train.contains("learning_rate")) {
-                training.learning_rate = ANN::LearningRateConfig::from_json(train["learning_rate"]);
-            } else {
-                training.learning_rate = ANN::LearningRateConfig();
+void Config::load_from_json(const nlohmann::json& config_json) {
+    // Parse network configuration
+    if (config_json.contains("network")) {
+        auto net = config_json["network"];
+        network.layers = net.value("layers", std::vector<int>{784, 128, 64, 10});
+        network.activation = net.value("activation", "sigmoid");
+        network.huge_pages = net.value("huge_pages", false);
+        network.sparse_input_threshold = net.value("sparse_input_threshold", 0.0);
+        network.inference_precision = net.value("inference_precision", "double");
+        network.activation_kernel = net.value("activation_kernel", "exact");
+        // Parse weight initialization
+        if (net.contains("weight_init")) {
+            auto weight_init = net["weight_init"];
+            network.weight_init.method = weight_init.value("method", "uniform");
+            network.weight_init.range = weight_init.value("range", std::vector<double>{-1.0, 1.0});
+            if (weight_init.contains("seed")) {
+                network.weight_init.seed = weight_init["seed"].get<uint64_t>();
             }
+        } else {
+            network.weight_init.method = "uniform";
+            network.weight_init.range = {-1.0, 1.0};
         }
+    }
 
-        // Parse data configuration
-        if (config_json.contains("data")) {
-            auto data_config = config_json["data"];
-            data.train_path = data_config.value("train_path", "./data/mnist_images/train/");
-            data.test_path = data_config.value("test_path", "./data/mnist_images/test/");
-            data.image_size = data_config.value("image_size", std::vector<int>{28, 28});
-            data.normalize = data_config.value("normalize", true);
+    // Parse training configuration
+    if (config_json.contains("training")) {
+        auto train = config_json["training"];
+        training.epochs = train.value("epochs", 5);
+        training.shuffle = train.value("shuffle", true);
+        training.data_path = train.value("data_path", "./data/mnist_images/");
+        // Parse learning rate schedule
+        if (train.contains("learning_rate")) {
+            training.learning_rate = ANN::LearningRateConfig::from_json(train["learning_rate"]);
+        } else {
+            training.learning_rate = ANN::LearningRateConfig();
         }
-
-        // Parse output configuration
-        if (config_json.contains("output")) {
-            auto output_config = config_json["output"];
-            output.save_plots = output_config.value("save_plots", true);
-            output.loss_file = output_config.value("loss_file", "training_loss.csv");
+        training.fused_update = train.value("fused_update", false);
+        training.validation_split = train.value("validation_split", 0.0);
+        if (train.contains("early_stopping")) {
+            auto early_stopping = train["early_stopping"];
+            training.early_stopping.enabled = early_stopping.value("enabled", false);
+            training.early_stopping.patience = early_stopping.value("patience", 3);
+            training.early_stopping.min_delta = early_stopping.value("min_delta", 0.0);
         }
+        if (train.contains("augmentation")) {
+            auto augmentation = train["augmentation"];
+            training.augmentation.enabled = augmentation.value("enabled", true);
+            training.augmentation.shift = augmentation.value("shift", 2.0);
+            training.augmentation.rotation = augmentation.value("rotation", 10.0);
+            training.augmentation.scale = augmentation.value("scale", 0.1);
+            training.augmentation.elastic_alpha = augmentation.value("elastic_alpha", 0.0);
+            training.augmentation.elastic_sigma = augmentation.value("elastic_sigma", 4.0);
+            training.augmentation.noise = augmentation.value("noise", 0.0);
+            training.augmentation.threads = augmentation.value("threads", 2);
+            training.augmentation.batch_size = augmentation.value("batch_size", 64);
+            training.augmentation.queue_batches = augmentation.value("queue_batches", 8);
+        }
+        if (train.contains("distillation")) {
+            auto distillation = train["distillation"];
+            training.distillation.enabled = distillation.value("enabled", true);
+            training.distillation.teacher = distillation.value("teacher", "");
+            training.distillation.temperature = distillation.value("temperature", 4.0);
+            training.distillation.alpha = distillation.value("alpha", 0.7);
+        }
+        if (train.contains("checkpoint")) {
+            auto checkpoint = train["checkpoint"];
+            training.checkpoint.enabled = checkpoint.value("enabled", true);
+            training.checkpoint.directory = checkpoint.value("directory", "checkpoints");
+            training.checkpoint.interval = checkpoint.value("interval", 0);
+            training.checkpoint.delta = checkpoint.value("delta", true);
+            training.checkpoint.full_interval = checkpoint.value("full_interval", 10);
+            training.checkpoint.resume = checkpoint.value("resume", true);
+        }
+    }
 
-    } catch (const std::exception& e) {
-        std::cerr << "Error loading config: " << e.what() << std::endl;
-        load_defaults();
+    // Parse data configuration
+    if (config_json.contains("data")) {
+        auto data_config = config_json["data"];
+        data.train_path = data_config.value("train_path", "./data/mnist_images/train/");
+        data.test_path = data_config.value("test_path", "./data/mnist_images/test/");
+        data.image_size = data_config.value("image_size", std::vector<int>{28, 28});
+        data.normalize = data_config.value("normalize", true);
+        data.loader_threads = data_config.value("loader_threads", 0);
+    }
+
+    // Parse evaluation configuration
+    if (config_json.contains("evaluation")) {
+        auto evaluation_config = config_json["evaluation"];
+        evaluation.threads = evaluation_config.value("threads", 0);
+        evaluation.batch_size = evaluation_config.value("batch_size", 64);
+    }
+
+    // Parse output configuration
+    if (config_json.contains("output")) {
+        auto output_config = config_json["output"];
+        output.save_plots = output_config.value("save_plots", true);
+        output.loss_file = output_config.value("loss_file", "training_loss.csv");
+        output.save_profile = output_config.value("save_profile", true);
+        output.perf_counters = output_config.value("perf_counters", false);
+        output.weight_snapshots = output_config.value("weight_snapshots", 0);
+        output.metrics_stream = output_config.value("metrics_stream", false);
+    }
+
+    // Parse distributed training configuration
+    if (config_json.contains("distributed")) {
+        auto distributed_config = config_json["distributed"];
+        distributed.host = distributed_config.value("host", "127.0.0.1");
+        distributed.port = distributed_config.value("port", 5555);
+        distributed.workers = distributed_config.value("workers", 2);
+        distributed.mode = distributed_config.value("mode", "async");
+        distributed.staleness = distributed_config.value("staleness", 2);
+        distributed.sync_interval = distributed_config.value("sync_interval", 64);
+    }
+
+    // Parse online learning configuration
+    if (config_json.contains("online")) {
+        auto online_config = config_json["online"];
+        online.replay_capacity = online_config.value("replay_capacity", 5000);
+        online.replay_ratio = online_config.value("replay_ratio", 2);
+        online.learning_rate = online_config.value("learning_rate", 0.005);
+        online.publish_interval = online_config.value("publish_interval", 0);
     }
 }
 
 void Config::save_to_file(const std::string& config_file) const {
+    std::ofstream file(config_file);
+    file << to_json().dump(2);  // Pretty print with 2-space indentation
+}
+
+nlohmann::json Config::to_json() const {
     nlohmann::json config_json;
     // Network configuration
     config_json["network"]["layers"] = network.layers;
     config_json["network"]["activation"] = network.activation;
+    config_json["network"]["huge_pages"] = network.huge_pages;
+    config_json["network"]["sparse_input_threshold"] = network.sparse_input_threshold;
+    config_json["network"]["inference_precision"] = network.inference_precision;
+    config_json["network"]["activation_kernel"] = network.activation_kernel;
     config_json["network"]["weight_init"]["method"] = network.weight_init.method;
     config_json["network"]["weight_init"]["range"] = network.weight_init.range;
+    if (network.weight_init.seed) {
+        config_json["network"]["weight_init"]["seed"] = *network.weight_init.seed;
+    }
     // Training configuration
     config_json["training"]["epochs"] = training.epochs;
     config_json["training"]["shuffle"] = training.shuffle;
     config_json["training"]["data_path"] = training.data_path;
-    config_json["training"]["learning_rate"] = {
-        {"initial", training.learning_rate.initial},
-        {"schedule", training.learning_rate.schedule},
-        {"decay", training.learning_rate.decay},
-        {"min", training.learning_rate.min},
-        {"step", training.learning_rate.step}
-    };
+    config_json["training"]["learning_rate"] = training.learning_rate.to_json();
+    config_json["training"]["fused_update"] = training.fused_update;
+    config_json["training"]["validation_split"] = training.validation_split;
+    config_json["training"]["early_stopping"]["enabled"] = training.early_stopping.enabled;
+    config_json["training"]["early_stopping"]["patience"] = training.early_stopping.patience;
+    config_json["training"]["early_stopping"]["min_delta"] = training.early_stopping.min_delta;
+    config_json["training"]["augmentation"]["enabled"] = training.augmentation.enabled;
+    config_json["training"]["augmentation"]["shift"] = training.augmentation.shift;
+    config_json["training"]["augmentation"]["rotation"] = training.augmentation.rotation;
+    config_json["training"]["augmentation"]["scale"] = training.augmentation.scale;
+    config_json["training"]["augmentation"]["elastic_alpha"] = training.augmentation.elastic_alpha;
+    config_json["training"]["augmentation"]["elastic_sigma"] = training.augmentation.elastic_sigma;
+    config_json["training"]["augmentation"]["noise"] = training.augmentation.noise;
+    config_json["training"]["augmentation"]["threads"] = training.augmentation.threads;
+    config_json["training"]["augmentation"]["batch_size"] = training.augmentation.batch_size;
+    config_json["training"]["augmentation"]["queue_batches"] = training.augmentation.queue_batches;
+    config_json["training"]["distillation"]["enabled"] = training.distillation.enabled;
+    config_json["training"]["distillation"]["teacher"] = training.distillation.teacher;
+    config_json["training"]["distillation"]["temperature"] = training.distillation.temperature;
+    config_json["training"]["distillation"]["alpha"] = training.distillation.alpha;
+    config_json["training"]["checkpoint"]["enabled"] = training.checkpoint.enabled;
+    config_json["training"]["checkpoint"]["directory"] = training.checkpoint.directory;
+    config_json["training"]["checkpoint"]["interval"] = training.checkpoint.interval;
+    config_json["training"]["checkpoint"]["delta"] = training.checkpoint.delta;
+    config_json["training"]["checkpoint"]["full_interval"] = training.checkpoint.full_interval;
+    config_json["training"]["checkpoint"]["resume"] = training.checkpoint.resume;
     // Data configuration
     config_json["data"]["train_path"] = data.train_path;
     config_json["data"]["test_path"] = data.test_path;
     config_json["data"]["image_size"] = data.image_size;
     config_json["data"]["normalize"] = data.normalize;
+    config_json["data"]["loader_threads"] = data.loader_threads;
+    // Evaluation configuration
+    config_json["evaluation"]["threads"] = evaluation.threads;
+    config_json["evaluation"]["batch_size"] = evaluation.batch_size;
     // Output configuration
     config_json["output"]["save_plots"] = output.save_plots;
     config_json["output"]["loss_file"] = output.loss_file;
-    std::ofstream file(config_file);
-    file << config_json.dump(2);  // Pretty print with 2-space indentation
+    config_json["output"]["save_profile"] = output.save_profile;
+    config_json["output"]["perf_counters"] = output.perf_counters;
+    config_json["output"]["weight_snapshots"] = output.weight_snapshots;
+    config_json["output"]["metrics_stream"] = output.metrics_stream;
+    // Distributed training configuration
+    config_json["distributed"]["host"] = distributed.host;
+    config_json["distributed"]["port"] = distributed.port;
+    config_json["distributed"]["workers"] = distributed.workers;
+    config_json["distributed"]["mode"] = distributed.mode;
+    config_json["distributed"]["staleness"] = distributed.staleness;
+    config_json["distributed"]["sync_interval"] = distributed.sync_interval;
+    // Online learning configuration
+    config_json["online"]["replay_capacity"] = online.replay_capacity;
+    config_json["online"]["replay_ratio"] = online.replay_ratio;
+    config_json["online"]["learning_rate"] = online.learning_rate;
+    config_json["online"]["publish_interval"] = online.publish_interval;
+    return config_json;
 }
 
 void Config::load_defaults() {
     network.layers = {784, 128, 64, 10};
     network.activation = "sigmoid";
+    network.huge_pages = false;
+    network.sparse_input_threshold = 0.0;
+    network.inference_precision = "double";
+    network.activation_kernel = "exact";
     network.weight_init.method = "uniform";
     network.weight_init.range = {-1.0, 1.0};
+    network.weight_init.seed.reset();
     training.epochs = 5;
     training.shuffle = true;
     training.data_path = "./data/mnist_images/";
     training.learning_rate = ANN::LearningRateConfig();
+    training.fused_update = false;
+    training.validation_split = 0.0;
+    training.early_stopping.enabled = false;
+    training.early_stopping.patience = 3;
+    training.early_stopping.min_delta = 0.0;
+    training.augmentation.enabled = false;
+    training.augmentation.shift = 2.0;
+    training.augmentation.rotation = 10.0;
+    training.augmentation.scale = 0.1;
+    training.augmentation.elastic_alpha = 0.0;
+    training.augmentation.elastic_sigma = 4.0;
+    training.augmentation.noise = 0.0;
+    training.augmentation.threads = 2;
+    training.augmentation.batch_size = 64;
+    training.augmentation.queue_batches = 8;
+    training.distillation.enabled = false;
+    training.distillation.teacher = "";
+    training.distillation.temperature = 4.0;
+    training.distillation.alpha = 0.7;
+    training.checkpoint.enabled = false;
+    training.checkpoint.directory = "checkpoints";
+    training.checkpoint.interval = 0;
+    training.checkpoint.delta = true;
+    training.checkpoint.full_interval = 10;
+    training.checkpoint.resume = true;
     data.train_path = "./data/mnist_images/train/";
     data.test_path = "./data/mnist_images/test/";
     data.image_size = {28, 28};
     data.normalize = true;
+    data.loader_threads = 0;
+    evaluation.threads = 0;
+    evaluation.batch_size = 64;
     output.save_plots = true;
     output.loss_file = "training_loss.csv";
+    output.save_profile = true;
+    output.perf_counters = false;
+    output.weight_snapshots = 0;
+    output.metrics_stream = false;
+    distributed.host = "127.0.0.1";
+    distributed.port = 5555;
+    distributed.workers = 2;
+    distributed.mode = "async";
+    distributed.staleness = 2;
+    distributed.sync_interval = 64;
+    online.replay_capacity = 5000;
+    online.replay_ratio = 2;
+    online.learning_rate = 0.005;
+    online.publish_interval = 0;
 }
 
 Config::Config(const std::string& config_file) {
@@ -120,6 +297,11 @@ Config::Config(const std::string& config_file) {
     load_from_file(config_file);
 }
 
+Config::Config(const nlohmann::json& config_json) {
+    load_defaults();
+    load_from_json(config_json);
+}
+
 void Config::print() const {
     std::cout << "=== CONFIGURATION ===" << std::endl;
     std::cout << "Network:" << std::endl;
@@ -130,7 +312,12 @@ void Config::print() const {
     }
     std::cout << "]" << std::endl;
     std::cout << "\tActivation:\t" << network.activation << std::endl;
+    std::cout << "\tHuge Pages:\t" << (network.huge_pages ? "true" : "false") << std::endl;
+    std::cout << "\tSparse Input Threshold:\t" << network.sparse_input_threshold << std::endl;
+    std::cout << "\tInference Precision:\t" << network.inference_precision << std::endl;
+    std::cout << "\tActivation Kernel:\t" << network.activation_kernel << std::endl;
     std::cout << "\tWeight Init:\t" << network.weight_init.method << " (" << network.weight_init.range[0] << ", " << network.weight_init.range[1] << ")" << std::endl;
+    std::cout << "\tWeight Seed:\t" << (network.weight_init.seed ? std::to_string(*network.weight_init.seed) : "random") << std::endl;
     std::cout << "Training:" << std::endl;
     std::cout << "\tEpochs:\t" << training.epochs << std::endl;
     std::cout << "\tShuffle:\t" << (training.shuffle ? "true" : "false") << std::endl;
@@ -140,11 +327,56 @@ void Config::print() const {
     std::cout << "\tLearning Rate Decay:\t" << training.learning_rate.decay << std::endl;
     std::cout << "\tLearning Rate Min:\t" << training.learning_rate.min << std::endl;
     std::cout << "\tLearning Rate Step:\t" << training.learning_rate.step << std::endl;
+    std::cout << "\tLearning Rate Gamma:\t" << training.learning_rate.gamma << std::endl;
+    std::cout << "\tLearning Rate Warmup:\t" << training.learning_rate.warmup_epochs << " epochs" << std::endl;
+    std::cout << "\tLearning Rate Update:\t" << training.learning_rate.update << std::endl;
+    std::cout << "\tFused Update:\t" << (training.fused_update ? "true" : "false") << std::endl;
+    std::cout << "\tValidation Split:\t" << training.validation_split << std::endl;
+    std::cout << "\tEarly Stopping:\t" << (training.early_stopping.enabled ? "true" : "false")
+              << " (patience " << training.early_stopping.patience << ", min delta " << training.early_stopping.min_delta << ")" << std::endl;
+    std::cout << "\tAugmentation:\t" << (training.augmentation.enabled ? "true" : "false");
+    if (training.augmentation.enabled) {
+        std::cout << " (shift " << training.augmentation.shift << "px, rotation " << training.augmentation.rotation
+                  << " deg, scale " << training.augmentation.scale << ", elastic " << training.augmentation.elastic_alpha
+                  << "/" << training.augmentation.elastic_sigma << ", noise " << training.augmentation.noise << ")";
+    }
+    std::cout << std::endl;
+    std::cout << "\tDistillation:\t" << (training.distillation.enabled ? "true" : "false");
+    if (training.distillation.enabled) {
+        std::cout << " (teacher " << training.distillation.teacher << ", temperature " << training.distillation.temperature
+                  << ", alpha " << training.distillation.alpha << ")";
+    }
+    std::cout << std::endl;
+    std::cout << "\tCheckpoints:\t" << (training.checkpoint.enabled ? "true" : "false");
+    if (training.checkpoint.enabled) {
+        std::cout << " (" << training.checkpoint.directory << ", every "
+                  << (training.checkpoint.interval > 0 ? std::to_string(training.checkpoint.interval) + " samples and " : "")
+                  << "epoch, " << (training.checkpoint.delta ? "delta, full every " + std::to_string(training.checkpoint.full_interval) : "full")
+                  << (training.checkpoint.resume ? ", resume" : "") << ")";
+    }
+    std::cout << std::endl;
     std::cout << "Data:" << std::endl;
     std::cout << "\tTrain Path:\t" << data.train_path << std::endl;
     std::cout << "\tTest Path:\t" << data.test_path << std::endl;
     std::cout << "\tImage Size:\t" << data.image_size[0] << "x" << data.image_size[1] << std::endl;
     std::cout << "\tNormalize:\t" << (data.normalize ? "true" : "false") << std::endl;
+    std::cout << "\tLoader Threads:\t" << data.loader_threads << std::endl;
+    std::cout << "Evaluation:" << std::endl;
+    std::cout << "\tThreads:\t" << evaluation.threads << std::endl;
+    std::cout << "\tBatch Size:\t" << evaluation.batch_size << std::endl;
+    std::cout << "Distributed:" << std::endl;
+    std::cout << "\tServer:\t" << distributed.host << ":" << distributed.port << std::endl;
+    std::cout << "\tWorkers:\t" << distributed.workers << std::endl;
+    std::cout << "\tMode:\t" << distributed.mode;
+    if (distributed.mode == "bounded") {
+        std::cout << " (staleness " << distributed.staleness << ")";
+    }
+    std::cout << std::endl;
+    std::cout << "\tSync Interval:\t" << distributed.sync_interval << " samples" << std::endl;
+    std::cout << "Online:" << std::endl;
+    std::cout << "\tReplay:\t" << online.replay_capacity << " samples, " << online.replay_ratio << " per update sample" << std::endl;
+    std::cout << "\tLearning Rate:\t" << online.learning_rate << std::endl;
+    std::cout << "\tPublish Interval:\t" << online.publish_interval << " samples" << std::endl;
     std::cout << "=====================" << std::endl;
 }
 
@@ -157,6 +389,105 @@ bool Config::validate() const {
         std::cerr << "Error: Initial learning rate must be between 0 and 1" << std::endl;
         return false;
     }
+    if (network.sparse_input_threshold < 0.0 || network.sparse_input_threshold > 1.0) {
+        std::cerr << "Error: Sparse input threshold must be between 0 and 1" << std::endl;
+        return false;
+    }
+    if (!ANN::parse_precision(network.inference_precision)) {
+        std::cerr << "Error: Inference precision must be \"double\", \"float16\" or \"bfloat16\"" << std::endl;
+        return false;
+    }
+    if (!ANN::parse_activation_kernel(network.activation_kernel)) {
+        std::cerr << "Error: Activation kernel must be \"exact\", \"table\" or \"polynomial\"" << std::endl;
+        return false;
+    }
+    if (!ANN::LearningRateConfig::is_known_schedule(training.learning_rate.schedule)) {
+        std::cerr << "Error: Unknown learning rate schedule: " << training.learning_rate.schedule << std::endl;
+        return false;
+    }
+    if (training.learning_rate.update != "epoch" && training.learning_rate.update != "iteration") {
+        std::cerr << "Error: Learning rate update must be \"epoch\" or \"iteration\"" << std::endl;
+        return false;
+    }
+    if (evaluation.batch_size <= 0) {
+        std::cerr << "Error: Evaluation batch size must be positive" << std::endl;
+        return false;
+    }
+    if (training.validation_split < 0.0 || training.validation_split >= 1.0) {
+        std::cerr << "Error: Validation split must be in [0, 1)" << std::endl;
+        return false;
+    }
+    if (training.early_stopping.enabled && training.validation_split <= 0.0) {
+        std::cerr << "Error: Early stopping needs a validation split" << std::endl;
+        return false;
+    }
+    if (training.early_stopping.patience <= 0) {
+        std::cerr << "Error: Early stopping patience must be positive" << std::endl;
+        return false;
+    }
+    if (output.weight_snapshots < 0) {
+        std::cerr << "Error: Weight snapshot interval must not be negative" << std::endl;
+        return false;
+    }
+    if (training.augmentation.enabled) {
+        const auto& augmentation = training.augmentation;
+        if (augmentation.shift < 0.0 || augmentation.rotation < 0.0 || augmentation.scale < 0.0 || augmentation.scale >= 1.0
+            || augmentation.elastic_alpha < 0.0 || augmentation.noise < 0.0) {
+            std::cerr << "Error: Augmentation ranges must not be negative, scale must be below 1" << std::endl;
+            return false;
+        }
+        if (augmentation.elastic_alpha > 0.0 && augmentation.elastic_sigma <= 0.0) {
+            std::cerr << "Error: Elastic distortion needs a positive sigma" << std::endl;
+            return false;
+        }
+        if (augmentation.threads < 0 || augmentation.batch_size <= 0 || augmentation.queue_batches <= 0) {
+            std::cerr << "Error: Augmentation batch size and queue must be positive" << std::endl;
+            return false;
+        }
+        if (data.image_size.size() != 2 || data.image_size[0] <= 0 || data.image_size[1] <= 0) {
+            std::cerr << "Error: Augmentation needs the image size" << std::endl;
+            return false;
+        }
+    }
+    if (training.distillation.enabled) {
+        const auto& distillation = training.distillation;
+        if (distillation.teacher.empty()) {
+            std::cerr << "Error: Distillation needs a teacher weights file" << std::endl;
+            return false;
+        }
+        if (distillation.temperature <= 0.0 || distillation.alpha < 0.0 || distillation.alpha > 1.0) {
+            std::cerr << "Error: Distillation temperature must be positive and alpha in [0, 1]" << std::endl;
+            return false;
+        }
+    }
+    if (training.checkpoint.enabled) {
+        const auto& checkpoint = training.checkpoint;
+        if (checkpoint.directory.empty()) {
+            std::cerr << "Error: Checkpoints need a directory" << std::endl;
+            return false;
+        }
+        if (checkpoint.interval < 0 || checkpoint.full_interval <= 0) {
+            std::cerr << "Error: Checkpoint interval must not be negative, full interval must be positive" << std::endl;
+            return false;
+        }
+    }
+    if (distributed.mode != "async" && distributed.mode != "bounded") {
+        std::cerr << "Error: Distributed mode must be \"async\" or \"bounded\"" << std::endl;
+        return false;
+    }
+    if (distributed.port < 0 || distributed.port > 65535 || distributed.workers <= 0
+        || distributed.staleness < 0 || distributed.sync_interval <= 0) {
+        std::cerr << "Error: Distributed port must be 0-65535, workers and sync interval positive, staleness not negative" << std::endl;
+        return false;
+    }
+    if (online.replay_capacity < 0 || online.replay_ratio < 0 || online.publish_interval < 0) {
+        std::cerr << "Error: Online replay capacity, replay ratio and publish interval must not be negative" << std::endl;
+        return false;
+    }
+    if (online.learning_rate <= 0.0 || online.learning_rate > 1.0) {
+        std::cerr << "Error: Online learning rate must be between 0 and 1" << std::endl;
+        return false;
+    }
     if (training.epochs <= 0) {
         std::cerr << "Error: Epochs must be positive" << std::endl;
         return false;
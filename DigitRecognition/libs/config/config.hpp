@@ -1,3 +1,5 @@
+#pragma once
+
 #include <vector>
 #include <fstream>
 #include <nlohmann/json.hpp>
@@ -8,6 +10,10 @@ namespace ANN {
     struct OutputConfig {
         bool save_plots;
         std::string loss_file;
+        bool save_profile;      // per phase timing breakdown next to the loss csv
+        bool perf_counters;     // per layer hardware counters (Linux perf_event_open)
+        int weight_snapshots;   // epochs between first layer weight images, 0 = off
+        bool metrics_stream;    // every training metric as JSON lines, DigitRecog_Metrics_*.jsonl
     };
 
     struct Config {
@@ -15,6 +21,10 @@ namespace ANN {
             std::vector<int> layers;
             std::string activation;
             ANN::WeightInitConfig weight_init;
+            bool huge_pages;        // back the parameter arena with transparent huge pages
+            double sparse_input_threshold;  // first layer skips zero inputs at or below this density, 0 = off
+            std::string inference_precision;  // weights evaluation reads: "double", "float16" or "bfloat16"
+            std::string activation_kernel;    // sigmoid evaluation: "exact", "table" or "polynomial"
         } network;
 
         struct TrainingConfig {
@@ -22,6 +32,43 @@ namespace ANN {
             bool shuffle;
             std::string data_path;
             ANN::LearningRateConfig learning_rate;
+            bool fused_update;          // apply the SGD step inside the backward pass, no gradient buffers
+            double validation_split;    // fraction of the training set held back for validation, 0 = none
+
+            struct EarlyStoppingConfig {
+                bool enabled;
+                int patience;           // epochs without improvement before stopping
+                double min_delta;       // validation loss must drop by more than this to count
+            } early_stopping;
+
+            struct AugmentationConfig {
+                bool enabled;
+                double shift;           // max translation in pixels, each axis
+                double rotation;        // max rotation in degrees, either way
+                double scale;           // max zoom in or out as a fraction, 0.1 = 90% to 110%
+                double elastic_alpha;   // elastic distortion strength (Simard et al. use 34), 0 = off
+                double elastic_sigma;   // smoothness of the elastic displacement field in pixels
+                double noise;           // standard deviation of added gaussian noise, fraction of full scale, 0 = off
+                int threads;            // augmentation threads, 0 = one per hardware thread
+                int batch_size;         // samples augmented per work item
+                int queue_batches;      // augmented batches buffered ahead of training
+            } augmentation;
+
+            struct DistillationConfig {
+                bool enabled;
+                std::string teacher;    // weights file of the trained teacher network
+                double temperature;     // softmax temperature for the teacher's soft targets
+                double alpha;           // weight of the soft targets against the labels, 1 = teacher only
+            } distillation;
+
+            struct CheckpointConfig {
+                bool enabled;
+                std::string directory;  // where checkpoint_N.ckpt files are written
+                int interval;           // samples between checkpoints within an epoch, 0 = only at the end of each epoch
+                bool delta;             // store only what changed since the previous checkpoint
+                int full_interval;      // with delta, every full_interval-th checkpoint is stored in full
+                bool resume;            // continue from the latest checkpoint in directory, if there is one
+            } checkpoint;
         } training;
 
         struct DataConfig {
@@ -29,13 +76,38 @@ namespace ANN {
             std::string test_path;
             std::vector<int> image_size;
             bool normalize;
+            int loader_threads;     // threads decoding images, 0 = one per hardware thread
         } data;
 
+        struct EvaluationConfig {
+            int threads;            // inference threads, 0 = one per hardware thread
+            int batch_size;         // samples per inference batch
+        } evaluation;
+
         OutputConfig output;
 
+        struct DistributedConfig {
+            std::string host;       // parameter server the workers connect to
+            int port;               // server port, 0 lets the server pick a free one
+            int workers;            // worker processes the server waits for
+            std::string mode;       // "async" or "bounded"
+            int staleness;          // bounded: max pushes a worker may run ahead of the slowest
+            int sync_interval;      // samples trained locally between pushes
+        } distributed;
+
+        struct OnlineConfig {
+            int replay_capacity;    // past samples kept for rehearsal
+            int replay_ratio;       // replayed samples trained after each new one
+            double learning_rate;   // fixed rate for incremental updates
+            int publish_interval;   // new samples between weight swaps, 0 = once per update
+        } online;
+
         Config(const std::string& config_file = "config.json");
+        explicit Config(const nlohmann::json& config_json);
         void load_from_file(const std::string& config_file);
+        void load_from_json(const nlohmann::json& config_json);
         void save_to_file(const std::string& config_file) const;
+        nlohmann::json to_json() const;
         void load_defaults();
         void print() const;
         bool validate() const;
@@ -0,0 +1,119 @@
+#include "parameter_server.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace ANN {
+namespace Distributed {
+
+ParameterServer::ParameterServer(std::span<const double> parameters, const Settings& settings)
+    : settings_(settings)
+    , bounded_(settings.mode == "bounded")
+    , listener_(static_cast<uint16_t>(settings.port))
+    , parameters_(parameters.begin(), parameters.end())
+    , clocks_(std::max(1, settings.workers), 0)
+    , finished_(clocks_.size(), false)
+{
+}
+
+void ParameterServer::run() {
+    // One thread per worker, the parameter lock is only held to add an update and copy the result
+    std::vector<std::thread> connections;
+    for (uint32_t worker = 0; worker < clocks_.size(); ++worker) {
+        connections.emplace_back(&ParameterServer::serve, this, listener_.accept(), worker);
+    }
+    listener_.close();
+
+    for (auto& connection : connections) {
+        connection.join();
+    }
+}
+
+ServerStats ParameterServer::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ServerStats stats = stats_;
+    stats.mean_staleness = stats_.updates > 0 ? static_cast<double>(staleness_sum_) / stats_.updates : 0.0;
+    return stats;
+}
+
+void ParameterServer::serve(TcpSocket socket, uint32_t worker) {
+    try {
+        Message message;
+        if (!receive_message(socket, message) || message.type != MessageType::Hello) {
+            throw std::runtime_error("expected hello");
+        }
+
+        Message reply;
+        reply.type = MessageType::Welcome;
+        reply.worker = worker;
+        reply.workers = static_cast<uint32_t>(clocks_.size());
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            reply.version = version_;
+            reply.values = parameters_;
+        }
+        send_message(socket, reply);
+        reply.type = MessageType::Parameters;
+
+        while (receive_message(socket, message) && message.type != MessageType::Done) {
+            if (message.type != MessageType::Push || message.values.size() != parameters_.size()) {
+                throw std::runtime_error("unexpected message");
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < parameters_.size(); ++i) {
+                parameters_[i] += message.values[i];
+            }
+            const uint64_t staleness = version_ - std::min(version_, message.version);
+            version_++;
+            clocks_[worker]++;
+            stats_.updates++;
+            stats_.samples += message.samples;
+            stats_.max_staleness = std::max(stats_.max_staleness, staleness);
+            staleness_sum_ += staleness;
+            clock_advanced_.notify_all();
+
+            if (bounded_) {
+                auto within_bound = [&] {
+                    return clocks_[worker] <= slowest_clock() + static_cast<uint64_t>(settings_.staleness);
+                };
+                if (!within_bound()) {
+                    stats_.blocked_pushes++;
+                    clock_advanced_.wait(lock, within_bound);
+                }
+            }
+
+            reply.version = version_;
+            reply.values = parameters_;
+            lock.unlock();
+            send_message(socket, reply);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Parameter server: worker " << worker << " dropped: " << e.what() << std::endl;
+    }
+    retire(worker);
+}
+
+void ParameterServer::retire(uint32_t worker) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_[worker] = true;
+    }
+    clock_advanced_.notify_all();
+}
+
+// Workers that have not connected yet count with clock 0, finished ones no longer hold anyone back
+uint64_t ParameterServer::slowest_clock() const {
+    uint64_t slowest = std::numeric_limits<uint64_t>::max();
+    for (size_t worker = 0; worker < clocks_.size(); ++worker) {
+        if (!finished_[worker]) {
+            slowest = std::min(slowest, clocks_[worker]);
+        }
+    }
+    return slowest;
+}
+
+} // namespace Distributed
+} // namespace ANN
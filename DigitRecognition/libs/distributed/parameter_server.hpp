@@ -0,0 +1,75 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../config/config.hpp"
+#include "tcp.hpp"
+
+namespace ANN {
+namespace Distributed {
+
+    struct ServerStats {
+        uint64_t updates = 0;           // pushes applied
+        uint64_t samples = 0;           // training samples behind them
+        uint64_t max_staleness = 0;     // most updates from other workers applied between a pull and its push
+        double mean_staleness = 0.0;
+        uint64_t blocked_pushes = 0;    // replies held back by the staleness bound
+    };
+
+    //
+    // Holds the master copy of a network's parameters for workers training on other processes or hosts.
+    // Each worker pushes the change its local SGD steps made since its last pull, the server adds it to
+    // the master copy and replies with the latest parameters (Downpour SGD, Dean et al. 2012).
+    //
+    // mode "async" replies at once, workers never wait on each other.
+    // mode "bounded" counts each worker's pushes and holds a reply back while that worker is more than
+    // staleness pushes ahead of the slowest unfinished worker (stale synchronous parallel).
+    // staleness 0 keeps the workers in lock step.
+    //
+    class ParameterServer {
+    public:
+        using Settings = Config::DistributedConfig;
+
+        // Starts listening on settings.port straight away, 0 picks a free port
+        ParameterServer(std::span<const double> parameters, const Settings& settings);
+
+        ParameterServer(const ParameterServer&) = delete;
+        ParameterServer& operator=(const ParameterServer&) = delete;
+
+        uint16_t port() const { return listener_.port(); }
+
+        // Accept settings.workers connections and serve them until every worker is done.
+        // A worker whose connection drops is treated as done.
+        void run();
+
+        // Master copy, safe to read once run() has returned
+        const std::vector<double>& parameters() const { return parameters_; }
+        uint64_t version() const { return version_; }
+        ServerStats stats() const;
+
+    private:
+        void serve(TcpSocket socket, uint32_t worker);
+        void retire(uint32_t worker);
+        uint64_t slowest_clock() const;
+
+        Settings settings_;
+        bool bounded_;
+        TcpListener listener_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable clock_advanced_;
+        std::vector<double> parameters_;
+        uint64_t version_ = 0;
+        std::vector<uint64_t> clocks_;      // pushes per worker
+        std::vector<bool> finished_;
+        ServerStats stats_;
+        uint64_t staleness_sum_ = 0;
+    };
+
+} // namespace Distributed
+} // namespace ANN
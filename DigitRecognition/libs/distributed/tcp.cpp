@@ -0,0 +1,224 @@
+#include "tcp.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace ANN {
+namespace Distributed {
+
+namespace {
+
+#ifdef _WIN32
+    using NativeSocket = SOCKET;
+
+    struct WinsockInit {
+        WinsockInit() {
+            WSADATA data;
+            WSAStartup(MAKEWORD(2, 2), &data);
+        }
+        ~WinsockInit() { WSACleanup(); }
+    };
+
+    void ensure_init() {
+        static WinsockInit init;
+    }
+
+    void close_native(std::intptr_t handle) { closesocket(static_cast<SOCKET>(handle)); }
+#else
+    using NativeSocket = int;
+
+    void ensure_init() {}
+
+    void close_native(std::intptr_t handle) { ::close(static_cast<int>(handle)); }
+#endif
+
+    NativeSocket native(std::intptr_t handle) {
+        return static_cast<NativeSocket>(handle);
+    }
+
+    // Small messages go straight out rather than waiting to be merged
+    void set_no_delay(std::intptr_t handle) {
+        int flag = 1;
+        setsockopt(native(handle), IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&flag), sizeof(flag));
+    }
+
+    struct WireHeader {
+        uint32_t type;
+        uint32_t worker;
+        uint32_t workers;
+        uint32_t samples;
+        uint64_t version;
+        uint64_t count;
+    };
+    static_assert(sizeof(WireHeader) == 32);
+
+    // Sanity limit on a message body, far above any network this code trains
+    constexpr uint64_t max_values = uint64_t(1) << 30;
+
+} // namespace
+
+TcpSocket& TcpSocket::operator=(TcpSocket&& other) noexcept {
+    if (this != &other) {
+        close();
+        handle_ = other.handle_;
+        other.handle_ = -1;
+    }
+    return *this;
+}
+
+TcpSocket TcpSocket::connect(const std::string& host, uint16_t port) {
+    ensure_init();
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    const std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses) != 0) {
+        throw std::runtime_error("Could not resolve host: " + host);
+    }
+
+    for (addrinfo* address = addresses; address; address = address->ai_next) {
+        auto handle = static_cast<std::intptr_t>(socket(address->ai_family, address->ai_socktype, address->ai_protocol));
+        if (handle == -1) {
+            continue;
+        }
+        if (::connect(native(handle), address->ai_addr, static_cast<int>(address->ai_addrlen)) == 0) {
+            freeaddrinfo(addresses);
+            set_no_delay(handle);
+            return TcpSocket(handle);
+        }
+        close_native(handle);
+    }
+    freeaddrinfo(addresses);
+    throw std::runtime_error("Could not connect to " + host + ":" + service);
+}
+
+void TcpSocket::send_all(const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+#ifdef MSG_NOSIGNAL
+        const auto sent = send(native(handle_), bytes, size, MSG_NOSIGNAL);
+#else
+        const auto sent = send(native(handle_), bytes, static_cast<int>(size), 0);
+#endif
+        if (sent <= 0) {
+            throw std::runtime_error("Connection lost while sending");
+        }
+        bytes += sent;
+        size -= static_cast<size_t>(sent);
+    }
+}
+
+bool TcpSocket::receive_all(void* data, size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        const auto received = recv(native(handle_), bytes, static_cast<int>(size), 0);
+        if (received == 0) {
+            return false;
+        }
+        if (received < 0) {
+            throw std::runtime_error("Connection lost while receiving");
+        }
+        bytes += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+void TcpSocket::close() {
+    if (handle_ != -1) {
+        close_native(handle_);
+        handle_ = -1;
+    }
+}
+
+TcpListener::TcpListener(uint16_t port, const std::string& bind_address) {
+    ensure_init();
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, bind_address.c_str(), &address.sin_addr) != 1) {
+        throw std::runtime_error("Invalid bind address: " + bind_address);
+    }
+
+    handle_ = static_cast<std::intptr_t>(socket(AF_INET, SOCK_STREAM, 0));
+    if (handle_ == -1) {
+        throw std::runtime_error("Could not create socket");
+    }
+    int reuse = 1;
+    setsockopt(native(handle_), SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    if (bind(native(handle_), reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || listen(native(handle_), 16) != 0) {
+        close();
+        throw std::runtime_error("Could not listen on port " + std::to_string(port));
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(native(handle_), reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+}
+
+TcpSocket TcpListener::accept() {
+    auto handle = static_cast<std::intptr_t>(::accept(native(handle_), nullptr, nullptr));
+    if (handle == -1) {
+        throw std::runtime_error("Accept failed on port " + std::to_string(port_));
+    }
+    set_no_delay(handle);
+    return TcpSocket(handle);
+}
+
+void TcpListener::close() {
+    if (handle_ != -1) {
+        close_native(handle_);
+        handle_ = -1;
+    }
+}
+
+void send_message(TcpSocket& socket, const Message& message) {
+    WireHeader header{static_cast<uint32_t>(message.type), message.worker, message.workers, message.samples,
+                      message.version, message.values.size()};
+    socket.send_all(&header, sizeof(header));
+    if (!message.values.empty()) {
+        socket.send_all(message.values.data(), message.values.size() * sizeof(double));
+    }
+}
+
+bool receive_message(TcpSocket& socket, Message& message) {
+    WireHeader header;
+    if (!socket.receive_all(&header, sizeof(header))) {
+        return false;
+    }
+    if (header.type < static_cast<uint32_t>(MessageType::Hello) || header.type > static_cast<uint32_t>(MessageType::Done)
+        || header.count > max_values) {
+        throw std::runtime_error("Malformed message from peer");
+    }
+
+    message.type = static_cast<MessageType>(header.type);
+    message.worker = header.worker;
+    message.workers = header.workers;
+    message.samples = header.samples;
+    message.version = header.version;
+    message.values.resize(header.count);
+    if (header.count > 0 && !socket.receive_all(message.values.data(), header.count * sizeof(double))) {
+        throw std::runtime_error("Connection closed mid message");
+    }
+    return true;
+}
+
+} // namespace Distributed
+} // namespace ANN
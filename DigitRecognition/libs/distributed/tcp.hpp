@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ANN {
+namespace Distributed {
+
+    //
+    // Blocking TCP stream, closed when destroyed. Errors throw std::runtime_error.
+    //
+    class TcpSocket {
+    public:
+        TcpSocket() = default;
+        explicit TcpSocket(std::intptr_t handle) : handle_(handle) {}
+        ~TcpSocket() { close(); }
+
+        TcpSocket(TcpSocket&& other) noexcept : handle_(other.handle_) { other.handle_ = -1; }
+        TcpSocket& operator=(TcpSocket&& other) noexcept;
+        TcpSocket(const TcpSocket&) = delete;
+        TcpSocket& operator=(const TcpSocket&) = delete;
+
+        // host is a name or address, e.g. "127.0.0.1"
+        static TcpSocket connect(const std::string& host, uint16_t port);
+
+        void send_all(const void* data, size_t size);
+        // False if the peer closed the connection before size bytes arrived
+        bool receive_all(void* data, size_t size);
+
+        bool is_open() const { return handle_ != -1; }
+        void close();
+
+    private:
+        std::intptr_t handle_ = -1;
+    };
+
+    //
+    // Listening socket, port 0 picks a free port (see port())
+    //
+    class TcpListener {
+    public:
+        explicit TcpListener(uint16_t port, const std::string& bind_address = "0.0.0.0");
+        ~TcpListener() { close(); }
+
+        TcpListener(const TcpListener&) = delete;
+        TcpListener& operator=(const TcpListener&) = delete;
+
+        TcpSocket accept();
+        uint16_t port() const { return port_; }
+        void close();
+
+    private:
+        std::intptr_t handle_ = -1;
+        uint16_t port_ = 0;
+    };
+
+    enum class MessageType : uint32_t {
+        Hello = 1,      // worker -> server, first message on a connection
+        Welcome,        // server -> worker, worker index, worker count and the current parameters
+        Push,           // worker -> server, parameter update computed against version
+        Parameters,     // server -> worker, reply to Push with the latest parameters
+        Done            // worker -> server, no more pushes
+    };
+
+    //
+    // One message on the wire: a fixed 32 byte header then count doubles. Byte order is the
+    // host's, as in the weights file, so every process must run on the same architecture.
+    //
+    struct Message {
+        MessageType type = MessageType::Hello;
+        uint32_t worker = 0;
+        uint32_t workers = 0;
+        uint32_t samples = 0;       // samples behind a Push
+        uint64_t version = 0;       // parameter version, updates applied by the server so far
+        std::vector<double> values;
+    };
+
+    void send_message(TcpSocket& socket, const Message& message);
+    // False if the peer closed the connection cleanly between messages
+    bool receive_message(TcpSocket& socket, Message& message);
+
+} // namespace Distributed
+} // namespace ANN
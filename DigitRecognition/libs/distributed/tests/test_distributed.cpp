@@ -0,0 +1,189 @@
+#include "../parameter_server.hpp"
+#include "../worker.hpp"
+#include "../../training/tests/test_fixtures.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+static const std::vector<int> topology = {16, 12, 10};
+
+static ANN::Config make_config(const std::string& mode, int workers) {
+    ANN::Config config = make_base_config(3);
+    config.distributed.port = 0;
+    config.distributed.workers = workers;
+    config.distributed.mode = mode;
+    config.distributed.staleness = 1;
+    config.distributed.sync_interval = 8;
+    return config;
+}
+
+bool test_message_round_trip() {
+    std::cout << "Testing a message round trip over localhost..." << std::endl;
+
+    ANN::Distributed::TcpListener listener(0, "127.0.0.1");
+    ASSERT_TRUE(listener.port() != 0);
+
+    ANN::Distributed::Message sent;
+    sent.type = ANN::Distributed::MessageType::Push;
+    sent.worker = 3;
+    sent.samples = 17;
+    sent.version = 123456789012ull;
+    sent.values = {1.5, -2.25, 1e-300};
+
+    std::thread client([&] {
+        auto socket = ANN::Distributed::TcpSocket::connect("127.0.0.1", listener.port());
+        ANN::Distributed::send_message(socket, sent);
+    });
+    auto socket = listener.accept();
+    ANN::Distributed::Message received;
+    ASSERT_TRUE(ANN::Distributed::receive_message(socket, received));
+    client.join();
+
+    ASSERT_TRUE(received.type == sent.type);
+    ASSERT_TRUE(received.worker == 3 && received.samples == 17 && received.version == sent.version);
+    ASSERT_TRUE(received.values == sent.values);
+    // The client closed its end, no more messages
+    ASSERT_TRUE(!ANN::Distributed::receive_message(socket, received));
+
+    std::cout << "✓ Message round trip passed" << std::endl;
+    return true;
+}
+
+// Server and workers on their own threads, exactly as separate processes would talk
+static bool train_over_localhost(const std::string& mode, int workers) {
+    const auto config = make_config(mode, workers);
+    const auto data_set = make_data_set(203);    // uneven shards, one worker finishes first
+
+    ANN::Network initial = make_network(42, topology, config.training.learning_rate);
+    const double initial_accuracy = accuracy(initial, data_set);
+    ANN::Distributed::ParameterServer server(initial.parameters(), config.distributed);
+
+    auto worker_config = config;
+    worker_config.distributed.port = server.port();
+
+    std::thread server_thread([&server] { server.run(); });
+
+    std::vector<uint64_t> pushes(workers, 0);
+    std::vector<int> samples(workers, 0);
+    std::vector<std::thread> worker_threads;
+    for (int w = 0; w < workers; ++w) {
+        worker_threads.emplace_back([&, w] {
+            // A different seed, the server's parameters replace these weights on connect
+            ANN::Network network = make_network(100 + w, topology, worker_config.training.learning_rate);
+            ANN::Distributed::DistributedTrainer trainer(network, worker_config.training, worker_config.distributed, w);
+            for (const auto& stats : trainer.run(data_set)) {
+                samples[trainer.worker_index()] += stats.samples;
+            }
+            pushes[trainer.worker_index()] = trainer.pushes();
+        });
+    }
+    for (auto& thread : worker_threads) {
+        thread.join();
+    }
+    server_thread.join();
+
+    const auto stats = server.stats();
+    uint64_t total_pushes = 0;
+    int total_samples = 0;
+    for (int w = 0; w < workers; ++w) {
+        total_pushes += pushes[w];
+        total_samples += samples[w];
+    }
+
+    // Every sample of every epoch was trained on exactly one worker and reached the server
+    ASSERT_TRUE(total_samples == 203 * config.training.epochs);
+    ASSERT_TRUE(stats.samples == static_cast<uint64_t>(total_samples));
+    ASSERT_TRUE(stats.updates == total_pushes);
+    ASSERT_TRUE(server.version() == total_pushes);
+    if (mode == "bounded") {
+        // A worker is at most staleness pushes ahead of or behind any other between its pull and push
+        const uint64_t bound = static_cast<uint64_t>(workers - 1) * (2 * config.distributed.staleness + 1);
+        ASSERT_TRUE(stats.max_staleness <= bound);
+    }
+
+    ANN::Network trained = make_network(42, topology, config.training.learning_rate);
+    std::ranges::copy(server.parameters(), trained.parameters().begin());
+    const double trained_accuracy = accuracy(trained, data_set);
+    std::cout << "  " << mode << ", " << workers << " workers: " << stats.updates << " updates, staleness max "
+              << stats.max_staleness << " mean " << stats.mean_staleness << ", accuracy " << initial_accuracy
+              << "% -> " << trained_accuracy << "%" << std::endl;
+    ASSERT_TRUE(trained_accuracy > 95.0);
+    return true;
+}
+
+bool test_async_training() {
+    std::cout << "Testing asynchronous parameter server training..." << std::endl;
+    ASSERT_TRUE(train_over_localhost("async", 3));
+    std::cout << "✓ Asynchronous training passed" << std::endl;
+    return true;
+}
+
+bool test_bounded_staleness_training() {
+    std::cout << "Testing bounded staleness parameter server training..." << std::endl;
+    ASSERT_TRUE(train_over_localhost("bounded", 3));
+    std::cout << "✓ Bounded staleness training passed" << std::endl;
+    return true;
+}
+
+bool test_topology_mismatch() {
+    std::cout << "Testing a worker with the wrong topology..." << std::endl;
+
+    auto config = make_config("async", 1);
+    ANN::Network server_network = make_network(1, topology, config.training.learning_rate);
+    ANN::Distributed::ParameterServer server(server_network.parameters(), config.distributed);
+    config.distributed.port = server.port();
+    std::thread server_thread([&server] { server.run(); });
+
+    ANN::Network network({16, 8, 10});
+    ANN::Distributed::DistributedTrainer trainer(network, config.training, config.distributed);
+    bool threw = false;
+    try {
+        trainer.run(make_data_set(8));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    server_thread.join();
+
+    ASSERT_TRUE(threw);
+    ASSERT_TRUE(server.stats().updates == 0);
+    std::cout << "✓ Topology mismatch passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Distributed Training Tests" << std::endl;
+    std::cout << "==================================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_message_round_trip();
+    all_passed &= test_async_training();
+    all_passed &= test_bounded_staleness_training();
+    all_passed &= test_topology_mismatch();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,106 @@
+#include "worker.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ANN {
+namespace Distributed {
+
+ParameterClient::ParameterClient(const std::string& host, uint16_t port)
+    : socket_(TcpSocket::connect(host, port))
+{
+    request_.type = MessageType::Hello;
+    send_message(socket_, request_);
+    if (!receive_message(socket_, reply_) || reply_.type != MessageType::Welcome) {
+        throw std::runtime_error("Parameter server did not welcome this worker");
+    }
+    worker_index_ = reply_.worker;
+    worker_count_ = std::max(1u, reply_.workers);
+    request_.worker = worker_index_;
+}
+
+ParameterClient::~ParameterClient() {
+    try {
+        finish();
+    } catch (const std::exception&) {
+        // The server is gone already, nothing to tell it
+    }
+}
+
+void ParameterClient::push(std::span<const double> update, uint32_t samples) {
+    request_.type = MessageType::Push;
+    request_.samples = samples;
+    request_.version = reply_.version;
+    request_.values.assign(update.begin(), update.end());
+    send_message(socket_, request_);
+
+    if (!receive_message(socket_, reply_) || reply_.type != MessageType::Parameters) {
+        throw std::runtime_error("Parameter server closed the connection");
+    }
+}
+
+void ParameterClient::finish() {
+    if (socket_.is_open()) {
+        request_.type = MessageType::Done;
+        request_.values.clear();
+        send_message(socket_, request_);
+        socket_.close();
+    }
+}
+
+DistributedTrainer::DistributedTrainer(Network& network, const Config::TrainingConfig& training_config,
+                                       const Config::DistributedConfig& settings, unsigned int seed)
+    : network_(network)
+    , training_config_(training_config)
+    , settings_(settings)
+    , seed_(seed)
+{
+}
+
+std::vector<EpochStats> DistributedTrainer::run(const TrainingSet& training_set) {
+    ParameterClient client(settings_.host, static_cast<uint16_t>(settings_.port));
+    worker_index_ = client.worker_index();
+    worker_count_ = client.worker_count();
+
+    auto parameters = network_.parameters();
+    if (client.parameters().size() != parameters.size()) {
+        throw std::runtime_error("Parameter server holds a different network topology");
+    }
+    std::ranges::copy(client.parameters(), parameters.begin());
+
+    const TrainingSet shard = shard_training_set(training_set, worker_index_, worker_count_);
+
+    // The change since the last sync, local parameters minus those the server last sent
+    std::vector<double> update(parameters.size());
+    int synced_samples = 0;
+    auto sync = [&](int samples) {
+        if (samples == synced_samples) {
+            return;
+        }
+        const auto& base = client.parameters();
+        for (size_t i = 0; i < update.size(); ++i) {
+            update[i] = parameters[i] - base[i];
+        }
+        client.push(update, static_cast<uint32_t>(samples - synced_samples));
+        std::ranges::copy(client.parameters(), parameters.begin());
+        synced_samples = samples;
+        pushes_++;
+    };
+
+    Trainer trainer(network_, training_config_, seed_);
+    trainer.on_progress([&](int samples, size_t, double) { sync(samples); }, std::max(1, settings_.sync_interval));
+    trainer.on_epoch_end([&](const EpochStats& stats) {
+        sync(stats.samples);
+        synced_samples = 0;
+        if (epoch_callback_) {
+            epoch_callback_(stats);
+        }
+    });
+
+    auto history = trainer.run(shard);
+    client.finish();
+    return history;
+}
+
+} // namespace Distributed
+} // namespace ANN
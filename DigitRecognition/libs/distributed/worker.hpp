@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../config/config.hpp"
+#include "../networks/networks.hpp"
+#include "../training/training.hpp"
+#include "tcp.hpp"
+
+namespace ANN {
+namespace Distributed {
+
+    //
+    // Worker end of one parameter server connection. Says hello on construction and
+    // receives the worker's index and the server's parameters.
+    //
+    class ParameterClient {
+    public:
+        ParameterClient(const std::string& host, uint16_t port);
+        ~ParameterClient();
+
+        uint32_t worker_index() const { return worker_index_; }
+        uint32_t worker_count() const { return worker_count_; }
+
+        // Latest parameters from the server and their version
+        const std::vector<double>& parameters() const { return reply_.values; }
+        uint64_t version() const { return reply_.version; }
+
+        // Send a change to add to the server's parameters, computed from version().
+        // Blocks until the server replies with its latest parameters, which in bounded
+        // mode waits for the slower workers to catch up.
+        void push(std::span<const double> update, uint32_t samples);
+
+        // Tell the server this worker is done, also sent by the destructor
+        void finish();
+
+    private:
+        TcpSocket socket_;
+        uint32_t worker_index_ = 0;
+        uint32_t worker_count_ = 1;
+        Message request_;
+        Message reply_;
+    };
+
+    //
+    // Trains a network on this worker's shard of a training set against a parameter server.
+    // Runs a normal Trainer on the local copy, and every sync_interval samples (and at the end
+    // of each epoch) pushes the change since the last sync and continues from the parameters
+    // the server sends back. The shard is every worker_count-th instance from the worker's index.
+    //
+    class DistributedTrainer {
+    public:
+        using EpochCallback = Trainer::EpochCallback;
+
+        DistributedTrainer(Network& network, const Config::TrainingConfig& training_config,
+                           const Config::DistributedConfig& settings, unsigned int seed = std::random_device{}());
+
+        void on_epoch_end(EpochCallback callback) { epoch_callback_ = std::move(callback); }
+
+        // Connect to settings.host:settings.port and train for training_config.epochs.
+        // Throws if the server holds parameters for a different topology.
+        std::vector<EpochStats> run(const TrainingSet& training_set);
+
+        uint32_t worker_index() const { return worker_index_; }
+        uint32_t worker_count() const { return worker_count_; }
+        uint64_t pushes() const { return pushes_; }
+
+    private:
+        Network& network_;
+        Config::TrainingConfig training_config_;
+        Config::DistributedConfig settings_;
+        unsigned int seed_;
+        EpochCallback epoch_callback_;
+
+        uint32_t worker_index_ = 0;
+        uint32_t worker_count_ = 1;
+        uint64_t pushes_ = 0;
+    };
+
+} // namespace Distributed
+} // namespace ANN
@@ -0,0 +1,175 @@
+#include "evaluation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+
+namespace ANN {
+
+double EvaluationResult::accuracy() const {
+    return total > 0 ? static_cast<double>(correct) / total * 100.0 : 0.0;
+}
+
+double EvaluationResult::average_loss() const {
+    return total > 0 ? total_loss / total : 0.0;
+}
+
+double EvaluationResult::precision(size_t label) const {
+    int predicted = 0;
+    for (size_t actual = 0; actual < num_classes(); ++actual) {
+        predicted += confusion[actual][label];
+    }
+    return predicted > 0 ? static_cast<double>(confusion[label][label]) / predicted * 100.0 : 0.0;
+}
+
+double EvaluationResult::recall(size_t label) const {
+    int actual = 0;
+    for (size_t predicted = 0; predicted < num_classes(); ++predicted) {
+        actual += confusion[label][predicted];
+    }
+    return actual > 0 ? static_cast<double>(confusion[label][label]) / actual * 100.0 : 0.0;
+}
+
+void EvaluationResult::print(std::ostream& out) const {
+    out << "Total tested: " << total << " images\n";
+    out << "Correct predictions: " << correct << "\n";
+    out << "Accuracy: " << std::fixed << std::setprecision(2) << accuracy() << "%\n";
+    out << "Average loss: " << std::fixed << std::setprecision(6) << average_loss() << "\n\n";
+
+    out << "Label  Precision  Recall\n";
+    for (size_t label = 0; label < num_classes(); ++label) {
+        out << std::setw(5) << label
+            << std::setw(10) << std::fixed << std::setprecision(2) << precision(label) << "%"
+            << std::setw(7) << std::fixed << std::setprecision(2) << recall(label) << "%\n";
+    }
+
+    out << "\nConfusion matrix (rows actual, columns predicted)\n      ";
+    for (size_t predicted = 0; predicted < num_classes(); ++predicted) {
+        out << std::setw(6) << predicted;
+    }
+    out << "\n";
+    for (size_t actual = 0; actual < num_classes(); ++actual) {
+        out << std::setw(6) << actual;
+        for (size_t predicted = 0; predicted < num_classes(); ++predicted) {
+            out << std::setw(6) << confusion[actual][predicted];
+        }
+        out << "\n";
+    }
+}
+
+bool EvaluationResult::save_csv(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "actual";
+    for (size_t predicted = 0; predicted < num_classes(); ++predicted) {
+        file << ",predicted_" << predicted;
+    }
+    file << ",precision,recall\n";
+
+    for (size_t actual = 0; actual < num_classes(); ++actual) {
+        file << actual;
+        for (size_t predicted = 0; predicted < num_classes(); ++predicted) {
+            file << "," << confusion[actual][predicted];
+        }
+        file << "," << precision(actual) << "," << recall(actual) << "\n";
+    }
+    return true;
+}
+
+EvaluationResult evaluate(const Network& network, const TrainingSet& data_set, unsigned int threads, size_t batch_size) {
+    const auto& instances = data_set.get_instances();
+    const size_t input_size = network.input_size();
+    const size_t output_size = network.output_size();
+    batch_size = std::max<size_t>(1, batch_size);
+
+    EvaluationResult result(output_size);
+    result.predictions.assign(instances.size(), -1);
+
+    const size_t batch_count = (instances.size() + batch_size - 1) / batch_size;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned int>(std::min<size_t>(threads, std::max<size_t>(1, batch_count)));
+
+    std::atomic<size_t> next_batch{0};
+    std::mutex merge_mutex;
+
+    auto worker = [&]() {
+        InferenceWorkspace workspace;
+        std::vector<double> batch_inputs;
+        EvaluationResult local(output_size);
+
+        for (size_t batch = next_batch++; batch < batch_count; batch = next_batch++) {
+            const size_t begin = batch * batch_size;
+            const size_t end = std::min(begin + batch_size, instances.size());
+
+            // Pack the batch contiguously, skipping images that failed to load
+            batch_inputs.clear();
+            std::vector<size_t> packed;
+            for (size_t i = begin; i < end; ++i) {
+                if (instances[i].input_data.size() == input_size) {
+                    batch_inputs.insert(batch_inputs.end(), instances[i].input_data.begin(), instances[i].input_data.end());
+                    packed.push_back(i);
+                }
+            }
+            if (packed.empty()) {
+                continue;
+            }
+
+            const auto& outputs = network.infer_batch(batch_inputs.data(), packed.size(), workspace);
+
+            for (size_t s = 0; s < packed.size(); ++s) {
+                const double* sample_outputs = &outputs[s * output_size];
+                const int label = instances[packed[s]].label;
+                const int predicted = argmax(sample_outputs, output_size);
+
+                for (size_t o = 0; o < output_size; ++o) {
+                    double diff = sample_outputs[o] - (static_cast<int>(o) == label ? 1.0 : 0.0);
+                    local.total_loss += diff * diff / output_size;
+                }
+
+                // distinct indices per batch, no lock needed
+                result.predictions[packed[s]] = predicted;
+                local.total++;
+                if (predicted == label) {
+                    local.correct++;
+                }
+                if (label >= 0 && static_cast<size_t>(label) < output_size) {
+                    local.confusion[label][predicted]++;
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(merge_mutex);
+        result.total += local.total;
+        result.correct += local.correct;
+        result.total_loss += local.total_loss;
+        for (size_t a = 0; a < output_size; ++a) {
+            for (size_t p = 0; p < output_size; ++p) {
+                result.confusion[a][p] += local.confusion[a][p];
+            }
+        }
+    };
+
+    if (threads == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; ++t) {
+            workers.emplace_back(worker);
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+
+    return result;
+}
+
+} // namespace ANN
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../networks/networks.hpp"
+#include "../training/training.hpp"
+
+namespace ANN {
+
+    //
+    // Outcome of scoring a network on a labelled data set
+    //
+    struct EvaluationResult {
+        std::vector<std::vector<int>> confusion;    // [actual][predicted] counts
+        std::vector<int> predictions;               // predicted label per instance, in data set order
+        double total_loss = 0.0;                    // summed MSE against the one hot labels
+        int total = 0;
+        int correct = 0;
+
+        explicit EvaluationResult(size_t num_classes = 10)
+            : confusion(num_classes, std::vector<int>(num_classes, 0)) {}
+
+        size_t num_classes() const { return confusion.size(); }
+
+        double accuracy() const;                    // percent
+        double average_loss() const;
+        double precision(size_t label) const;       // percent, of the samples predicted as label
+        double recall(size_t label) const;          // percent, of the samples that are label
+
+        // Accuracy, per class precision/recall and the confusion matrix
+        void print(std::ostream& out) const;
+
+        // Confusion matrix with per class precision and recall columns
+        bool save_csv(const std::string& filename) const;
+    };
+
+    //
+    // Score a network on a data set with one forward pass per sample.
+    // The samples are split into batches that worker threads pull in turn, each thread with its
+    // own workspace, so the network is only read. threads = 0 uses one per hardware thread.
+    //
+    EvaluationResult evaluate(const Network& network, const TrainingSet& data_set,
+                              unsigned int threads = 0, size_t batch_size = 64);
+
+} // namespace ANN
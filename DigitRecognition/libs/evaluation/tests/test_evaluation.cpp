@@ -0,0 +1,275 @@
+#include "../evaluation.hpp"
+#include "../validation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+// Small random data set, labels spread over all classes
+ANN::TrainingSet make_data_set(size_t count, size_t input_size, int num_classes) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    ANN::TrainingSet data_set;
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<double> input(input_size);
+        for (auto& value : input) {
+            value = dist(rng);
+        }
+        data_set.add_instance({input, static_cast<int>(i % num_classes), "sample_" + std::to_string(i)});
+    }
+    return data_set;
+}
+
+bool test_infer_batch_matches_predict() {
+    std::cout << "Testing batched inference against predict_probabilities..." << std::endl;
+
+    ANN::Network network({12, 8, 6, 4});
+    auto data_set = make_data_set(10, 12, 4);
+    const auto& instances = data_set.get_instances();
+
+    std::vector<double> inputs;
+    for (const auto& instance : instances) {
+        inputs.insert(inputs.end(), instance.input_data.begin(), instance.input_data.end());
+    }
+
+    ANN::InferenceWorkspace workspace;
+    const auto& outputs = network.infer_batch(inputs.data(), instances.size(), workspace);
+    ASSERT_TRUE(outputs.size() == instances.size() * 4);
+
+    for (size_t i = 0; i < instances.size(); ++i) {
+        auto expected = network.predict_probabilities(instances[i].input_data);
+        for (size_t o = 0; o < expected.size(); ++o) {
+            ASSERT_NEAR(outputs[i * 4 + o], expected[o], 1e-12);
+        }
+    }
+
+    std::cout << "✓ Batched inference tests passed" << std::endl;
+    return true;
+}
+
+bool test_evaluate_matches_serial() {
+    std::cout << "Testing evaluate against a serial predict_label loop..." << std::endl;
+
+    ANN::Network network({12, 8, 4});
+    auto data_set = make_data_set(203, 12, 4);  // not a multiple of the batch size
+
+    int expected_correct = 0;
+    std::vector<int> expected_predictions;
+    for (const auto& instance : data_set.get_instances()) {
+        int predicted = network.predict_label(instance.input_data);
+        expected_predictions.push_back(predicted);
+        if (predicted == instance.label) {
+            expected_correct++;
+        }
+    }
+
+    for (unsigned int threads : {1u, 3u}) {
+        auto result = ANN::evaluate(network, data_set, threads, 16);
+        ASSERT_TRUE(result.total == 203);
+        ASSERT_TRUE(result.correct == expected_correct);
+        ASSERT_TRUE(result.predictions == expected_predictions);
+
+        // Every sample lands in exactly one cell, the diagonal holds the correct ones
+        int cells = 0, diagonal = 0;
+        for (size_t a = 0; a < result.num_classes(); ++a) {
+            for (size_t p = 0; p < result.num_classes(); ++p) {
+                cells += result.confusion[a][p];
+            }
+            diagonal += result.confusion[a][a];
+        }
+        ASSERT_TRUE(cells == 203);
+        ASSERT_TRUE(diagonal == expected_correct);
+    }
+
+    std::cout << "✓ Evaluate tests passed" << std::endl;
+    return true;
+}
+
+bool test_precision_recall() {
+    std::cout << "Testing precision and recall..." << std::endl;
+
+    ANN::EvaluationResult result(2);
+    // actual 0: 3 right, 1 wrong; actual 1: 2 right, 2 wrong
+    result.confusion = {{3, 1}, {2, 2}};
+    result.total = 8;
+    result.correct = 5;
+
+    ASSERT_NEAR(result.accuracy(), 62.5, 1e-10);
+    ASSERT_NEAR(result.precision(0), 60.0, 1e-10);   // 3 of the 5 predicted 0
+    ASSERT_NEAR(result.recall(0), 75.0, 1e-10);      // 3 of the 4 actual 0
+    ASSERT_NEAR(result.precision(1), 200.0 / 3.0, 1e-10);
+    ASSERT_NEAR(result.recall(1), 50.0, 1e-10);
+
+    std::cout << "✓ Precision and recall tests passed" << std::endl;
+    return true;
+}
+
+bool test_weights_round_trip() {
+    std::cout << "Testing weights file save and load..." << std::endl;
+
+    ANN::Network network({12, 8, 6, 4}, ANN::WeightInitConfig{}, ANN::LearningRateConfig{}, "relu");
+    const std::string filename = "test_evaluation_weights.bin";
+    ASSERT_TRUE(network.save(filename));
+
+    ANN::Network loaded = ANN::Network::load(filename);
+    std::remove(filename.c_str());
+
+    ASSERT_TRUE(loaded.layer_sizes() == network.layer_sizes());
+    ASSERT_TRUE(loaded.activation() == "relu");
+    for (size_t i = 0; i < network.layer_count(); ++i) {
+        ASSERT_TRUE(std::ranges::equal(loaded.layer_at(i).weights_, network.layer_at(i).weights_));
+        ASSERT_TRUE(std::ranges::equal(loaded.layer_at(i).biases_, network.layer_at(i).biases_));
+    }
+
+    std::cout << "✓ Weights file tests passed" << std::endl;
+    return true;
+}
+
+bool test_inference_mode() {
+    std::cout << "Testing inference mode..." << std::endl;
+
+    ANN::WeightInitConfig weight_config;
+    weight_config.seed = 17;
+    ANN::Network network({12, 8, 6, 4}, weight_config);
+    ANN::Network twin(network);
+    auto data_set = make_data_set(20, 12, 4);
+    const auto& instances = data_set.get_instances();
+
+    network.set_inference_mode(true);
+    ASSERT_TRUE(network.inference_mode() && network.gradients().empty());
+    for (size_t i = 0; i + 1 < network.layer_count(); ++i) {
+        ASSERT_TRUE(network.layer_at(i).pre_activations_.empty());
+    }
+    for (const auto& instance : instances) {
+        ASSERT_TRUE(network.predict_probabilities(instance.input_data) == twin.predict_probabilities(instance.input_data));
+    }
+
+    // Copies stay in inference mode, training leaves it and matches a network that never entered it
+    ANN::Network copy(network);
+    ASSERT_TRUE(copy.inference_mode() && copy.gradients().empty());
+    for (const auto& instance : instances) {
+        auto a = network.train(instance.input_data, instance.label);
+        auto b = twin.train(instance.input_data, instance.label);
+        ASSERT_TRUE(a.loss == b.loss);
+    }
+    ASSERT_TRUE(!network.inference_mode() && network.gradients().size() == network.parameters().size());
+    ASSERT_TRUE(std::ranges::equal(network.parameters(), twin.parameters()));
+
+    // The output layer keeps its pre-activations, logits come without leaving inference mode
+    network.set_inference_mode(true);
+    ASSERT_TRUE(network.predict_logits(instances[0].input_data) == twin.predict_logits(instances[0].input_data));
+    ASSERT_TRUE(network.inference_mode() && network.gradients().empty());
+
+    std::cout << "✓ Inference mode tests passed" << std::endl;
+    return true;
+}
+
+bool test_train_step_result() {
+    std::cout << "Testing the training step result..." << std::endl;
+
+    ANN::WeightInitConfig weight_config;
+    weight_config.seed = 23;
+    ANN::Network network({12, 8, 4}, weight_config);
+    auto data_set = make_data_set(12, 12, 4);
+
+    for (const auto& instance : data_set.get_instances()) {
+        // What the network saw before the step, from a copy the step cannot touch
+        ANN::Network before(network);
+        auto outputs = before.predict_probabilities(instance.input_data);
+        auto target = ANN::label_to_one_hot_vector(instance.label, 4);
+        double expected_loss = 0.0;
+        for (size_t o = 0; o < outputs.size(); ++o) {
+            expected_loss += (outputs[o] - target[o]) * (outputs[o] - target[o]);
+        }
+        expected_loss /= outputs.size();
+
+        auto step = network.train(instance.input_data, instance.label);
+        ASSERT_TRUE(step.predicted_label == before.predict_label(instance.input_data));
+        ASSERT_NEAR(step.loss, expected_loss, 1e-12);
+        ASSERT_TRUE(step.logits == before.predict_logits(instance.input_data));
+    }
+
+    std::vector<std::vector<double>> inputs(3, std::vector<double>(12, 0.5));
+    bool threw = false;
+    try {
+        network.train_batch(inputs, {0, 1});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    std::cout << "✓ Training step result tests passed" << std::endl;
+    return true;
+}
+
+bool test_async_validator_early_stopping() {
+    std::cout << "Testing asynchronous validation and early stopping..." << std::endl;
+
+    ANN::Network network({12, 8, 4});
+    auto validation_set = make_data_set(50, 12, 4);
+    auto expected = ANN::evaluate(network, validation_set, 1);
+
+    ANN::Config::TrainingConfig::EarlyStoppingConfig early_stopping{true, 2, 0.0};
+    ANN::AsyncValidator validator(validation_set, early_stopping, 16);
+
+    int results = 0;
+    validator.on_result([&results](const ANN::ValidationStats&) { results++; });
+
+    // The weights never change, so only the first snapshot is an improvement
+    for (int epoch = 1; epoch <= 3; ++epoch) {
+        validator.submit(network, epoch);
+    }
+    validator.wait();
+
+    ASSERT_TRUE(results == 3);
+    ASSERT_TRUE(validator.should_stop());
+    ASSERT_TRUE(validator.best_network().has_value());
+    ASSERT_TRUE(validator.best_stats().epoch == 1);
+    ASSERT_NEAR(validator.best_stats().loss, expected.average_loss(), 1e-12);
+
+    std::cout << "✓ Asynchronous validation tests passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Evaluation Library Tests" << std::endl;
+    std::cout << "================================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_infer_batch_matches_predict();
+    all_passed &= test_evaluate_matches_serial();
+    all_passed &= test_precision_recall();
+    all_passed &= test_weights_round_trip();
+    all_passed &= test_inference_mode();
+    all_passed &= test_train_step_result();
+    all_passed &= test_async_validator_early_stopping();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
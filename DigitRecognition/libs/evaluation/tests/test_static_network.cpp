@@ -0,0 +1,122 @@
+#include "../../networks/networks.hpp"
+#include "../../networks/static_network.hpp"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+using DigitNetwork = ANN::StaticNetwork<784, 128, 64, 10>;
+
+// Deterministic image-like input, mostly zero with a few bright pixels
+static std::vector<double> make_input(size_t size, int seed) {
+    std::vector<double> input(size, 0.0);
+    for (size_t i = 0; i < size; ++i) {
+        if ((i * 7 + seed * 13) % 5 == 0) {
+            input[i] = static_cast<double>((i + seed) % 11) / 10.0;
+        }
+    }
+    return input;
+}
+
+bool test_matches_dynamic_network() {
+    std::cout << "Testing StaticNetwork outputs against Network..." << std::endl;
+
+    for (const std::string activation : {"sigmoid", "relu"}) {
+        ANN::WeightInitConfig config;
+        config.seed = 3;
+        ANN::Network network({784, 128, 64, 10}, config, ANN::LearningRateConfig{}, activation);
+        auto fixed = std::make_unique<DigitNetwork>(network);
+        ASSERT_TRUE(fixed->activation() == activation);
+
+        ANN::InferenceWorkspace workspace;
+        for (int sample = 0; sample < 5; ++sample) {
+            auto input = make_input(784, sample);
+            const auto& expected = network.infer_batch(input.data(), 1, workspace);
+
+            DigitNetwork::Input fixed_input;
+            std::copy(input.begin(), input.end(), fixed_input.begin());
+            DigitNetwork::Output output;
+            fixed->infer(fixed_input, output);
+
+            for (size_t i = 0; i < output.size(); ++i) {
+                ASSERT_NEAR(output[i], expected[i], 1e-12);
+            }
+            ASSERT_TRUE(fixed->classify(fixed_input) == ANN::argmax(expected.data(), expected.size()));
+        }
+    }
+
+    std::cout << "✓ Dynamic network match tests passed" << std::endl;
+    return true;
+}
+
+bool test_shared_weights_file() {
+    std::cout << "Testing StaticNetwork reads and writes the Network weights file..." << std::endl;
+
+    using SmallNetwork = ANN::StaticNetwork<12, 8, 6, 4>;
+    ANN::Network network({12, 8, 6, 4}, ANN::WeightInitConfig{}, ANN::LearningRateConfig{}, "relu");
+    const std::string filename = "test_static_network_weights.bin";
+    ASSERT_TRUE(network.save(filename));
+
+    SmallNetwork fixed;
+    fixed.load(filename);
+    ASSERT_TRUE(fixed.activation() == "relu");
+    ASSERT_TRUE(std::ranges::equal(fixed.layer<1>().weights, network.layer_at(1).weights_));
+    ASSERT_TRUE(std::ranges::equal(fixed.layer<2>().biases, network.layer_at(2).biases_));
+
+    // And back again
+    ASSERT_TRUE(fixed.save(filename));
+    ANN::Network loaded = ANN::Network::load(filename);
+    for (size_t i = 0; i < network.layer_count(); ++i) {
+        ASSERT_TRUE(std::ranges::equal(loaded.layer_at(i).weights_, network.layer_at(i).weights_));
+        ASSERT_TRUE(std::ranges::equal(loaded.layer_at(i).biases_, network.layer_at(i).biases_));
+    }
+
+    // A file of another topology is refused
+    bool threw = false;
+    try {
+        ANN::StaticNetwork<12, 8, 4> other;
+        other.load(filename);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    std::remove(filename.c_str());
+    ASSERT_TRUE(threw);
+
+    std::cout << "✓ Weights file tests passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Static Network Tests" << std::endl;
+    std::cout << "============================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_matches_dynamic_network();
+    all_passed &= test_shared_weights_file();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
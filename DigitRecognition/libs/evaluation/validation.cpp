@@ -0,0 +1,60 @@
+#include "validation.hpp"
+
+#include <iostream>
+
+namespace ANN {
+
+AsyncValidator::AsyncValidator(const TrainingSet& validation_set, const Config::TrainingConfig::EarlyStoppingConfig& early_stopping,
+                               size_t batch_size)
+    : validation_set_(validation_set)
+    , early_stopping_(early_stopping)
+    , batch_size_(batch_size)
+    , worker_([this](Snapshot& snapshot) { score(snapshot); })
+{
+}
+
+AsyncValidator::~AsyncValidator() = default;
+
+void AsyncValidator::submit(const Network& network, int epoch) {
+    worker_.push_when_room(Snapshot{network, epoch}, 1);
+}
+
+void AsyncValidator::wait() {
+    worker_.wait();
+}
+
+void AsyncValidator::score(Snapshot& snapshot) {
+    // One scoring thread, the cores are busy training the next epoch
+    auto result = evaluate(snapshot.network, validation_set_, 1, batch_size_);
+
+    ValidationStats stats;
+    stats.epoch = snapshot.epoch;
+    stats.loss = result.average_loss();
+    stats.accuracy = result.accuracy();
+    stats.improved = !best_network_ || stats.loss < best_stats_.loss - early_stopping_.min_delta;
+
+    if (stats.improved) {
+        epochs_without_improvement_ = 0;
+        if (!checkpoint_file_.empty() && !snapshot.network.save(checkpoint_file_)) {
+            std::cerr << "Failed to save best checkpoint to: " << checkpoint_file_ << std::endl;
+        }
+    } else {
+        epochs_without_improvement_++;
+    }
+    stats.epochs_without_improvement = epochs_without_improvement_;
+
+    if (early_stopping_.enabled && epochs_without_improvement_ >= early_stopping_.patience) {
+        stop_training_ = true;
+    }
+
+    if (result_callback_) {
+        result_callback_(stats);
+    }
+
+    if (stats.improved) {
+        best_network_ = std::move(snapshot.network);
+        best_stats_ = stats;
+    }
+}
+
+} // namespace ANN
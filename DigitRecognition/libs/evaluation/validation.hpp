@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include "../config/config.hpp"
+#include "../networks/networks.hpp"
+#include "../threading/background_worker.hpp"
+#include "../training/training.hpp"
+#include "evaluation.hpp"
+
+namespace ANN {
+
+    //
+    // Score of one epoch's snapshot on the validation set
+    //
+    struct ValidationStats {
+        int epoch = 0;              // 1 based, the epoch the snapshot was taken after
+        double loss = 0.0;          // average loss
+        double accuracy = 0.0;      // percent
+        bool improved = false;      // new best loss
+        int epochs_without_improvement = 0;
+    };
+
+    //
+    // Scores copies of the network on a validation set on a background thread, so training
+    // carries on with the next epoch while the previous one is validated.
+    // Keeps a copy of the best network seen and, with early stopping enabled, raises
+    // should_stop() once the loss has not improved for patience epochs.
+    // At most one snapshot waits behind the one being scored, submit() blocks beyond that.
+    //
+    class AsyncValidator {
+    public:
+        using ResultCallback = std::function<void(const ValidationStats& stats)>;
+
+        AsyncValidator(const TrainingSet& validation_set, const Config::TrainingConfig::EarlyStoppingConfig& early_stopping,
+                       size_t batch_size = 64);
+        ~AsyncValidator();
+
+        AsyncValidator(const AsyncValidator&) = delete;
+        AsyncValidator& operator=(const AsyncValidator&) = delete;
+
+        // Called on the validator thread after each snapshot is scored
+        void on_result(ResultCallback callback) { result_callback_ = std::move(callback); }
+
+        // Also write each new best network to this file, from the validator thread
+        void set_checkpoint_file(const std::string& filename) { checkpoint_file_ = filename; }
+
+        // Queue a copy of the network as it is after epoch (1 based)
+        void submit(const Network& network, int epoch);
+
+        // Block until every submitted snapshot has been scored
+        void wait();
+
+        // Early stopping has triggered, lags the training loop by up to one epoch
+        bool should_stop() const { return stop_training_; }
+
+        // Best snapshot so far, empty until one has been scored. Call wait() first.
+        const std::optional<Network>& best_network() const { return best_network_; }
+        const ValidationStats& best_stats() const { return best_stats_; }
+
+    private:
+        struct Snapshot {
+            Network network;
+            int epoch;
+        };
+
+        void score(Snapshot& snapshot);
+
+        const TrainingSet& validation_set_;
+        Config::TrainingConfig::EarlyStoppingConfig early_stopping_;
+        size_t batch_size_;
+        std::string checkpoint_file_;
+        ResultCallback result_callback_;
+
+        // Validator thread only, read after wait()
+        std::optional<Network> best_network_;
+        ValidationStats best_stats_;
+        int epochs_without_improvement_ = 0;
+        std::atomic<bool> stop_training_{false};
+
+        BackgroundWorker<Snapshot> worker_;
+    };
+
+} // namespace ANN
@@ -0,0 +1,58 @@
+#include "idx.hpp"
+
+#include <stdexcept>
+
+namespace ANN {
+
+namespace {
+
+    constexpr uint32_t idx3_ubyte_magic = 0x00000803;
+
+    bool read_big_endian(std::istream& file, uint32_t& value) {
+        unsigned char bytes[4];
+        if (!file.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) {
+            return false;
+        }
+        value = (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | bytes[3];
+        return true;
+    }
+
+} // namespace
+
+IdxImageReader::IdxImageReader(const std::string& filename)
+    : file_(filename, std::ios::binary)
+    , filename_(filename)
+{
+    if (!file_.is_open()) {
+        throw std::runtime_error("Could not open IDX file: " + filename);
+    }
+
+    uint32_t magic = 0;
+    if (!read_big_endian(file_, magic) || magic != idx3_ubyte_magic) {
+        throw std::runtime_error("Not an IDX3 unsigned byte image file: " + filename);
+    }
+    if (!read_big_endian(file_, count_) || !read_big_endian(file_, rows_) || !read_big_endian(file_, columns_)
+        || rows_ == 0 || columns_ == 0) {
+        throw std::runtime_error("Corrupt IDX header: " + filename);
+    }
+}
+
+bool IdxImageReader::is_idx_image_file(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    uint32_t magic = 0;
+    return file.is_open() && read_big_endian(file, magic) && magic == idx3_ubyte_magic;
+}
+
+bool IdxImageReader::read(uint8_t* pixels) {
+    if (read_ >= count_) {
+        return false;
+    }
+    if (!file_.read(reinterpret_cast<char*>(pixels), static_cast<std::streamsize>(image_size()))) {
+        throw std::runtime_error("IDX file ends after " + std::to_string(read_) + " of " +
+                                 std::to_string(count_) + " images: " + filename_);
+    }
+    read_++;
+    return true;
+}
+
+} // namespace ANN
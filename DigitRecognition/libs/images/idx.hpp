@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace ANN {
+
+    //
+    // Streams the images of an IDX3 unsigned byte file, the format MNIST is distributed in
+    // (train-images-idx3-ubyte): a big endian header of magic 0x00000803, count, rows and columns,
+    // then count × rows × columns pixels, 0-255, row major. One image is read at a time so a
+    // file of any size takes no more memory than an image.
+    //
+    class IdxImageReader {
+    public:
+        // Throws std::runtime_error if the file cannot be opened or is not an IDX3 byte image file
+        explicit IdxImageReader(const std::string& filename);
+
+        // True if the file starts with the IDX3 unsigned byte magic
+        static bool is_idx_image_file(const std::string& filename);
+
+        uint32_t count() const { return count_; }
+        uint32_t rows() const { return rows_; }
+        uint32_t columns() const { return columns_; }
+        size_t image_size() const { return static_cast<size_t>(rows_) * columns_; }
+
+        // Next image into pixels (image_size() bytes), false once every image has been read.
+        // Throws if the file ends early.
+        bool read(uint8_t* pixels);
+
+    private:
+        std::ifstream file_;
+        std::string filename_;
+        uint32_t count_ = 0;
+        uint32_t rows_ = 0;
+        uint32_t columns_ = 0;
+        uint32_t read_ = 0;
+    };
+
+} // namespace ANN
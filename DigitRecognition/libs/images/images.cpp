@@ -66,17 +66,51 @@ std::vector<double> ANN::load_image(const std::string& filename) {
         return {};  // Return empty vector for unsupported formats
     }
 
+    return decode_image(read_file_bytes(filename));
+}
+
+std::vector<unsigned char> ANN::read_file_bytes(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Could not open file: " << filename << std::endl;
+        return {};
+    }
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    std::vector<unsigned char> bytes(static_cast<size_t>(size));
+    if (size > 0 && !file.read(reinterpret_cast<char*>(bytes.data()), size)) {
+        std::cerr << "Failed to read file: " << filename << std::endl;
+        return {};
+    }
+    return bytes;
+}
+
+bool ANN::init_image_decoding() {
+#if HAS_SDL_IMAGE
+    return get_sdl_manager().is_initialized();
+#else
+    return false;
+#endif
+}
+
+std::vector<double> ANN::decode_image(const std::vector<unsigned char>& bytes) {
+    if (bytes.empty()) {
+        return {};
+    }
+
+#if HAS_SDL_IMAGE
     // Real SDL2_image implementation
     auto& sdl_manager = get_sdl_manager();
     if (!sdl_manager.is_initialized()) {
         std::cerr << "SDL not initialized, err, help" << std::endl;
-        // Fall through to simulation code below
         return {};
     } 
 
-    // std::cout << "Using SDL2_image for real image loading..." << std::endl;
-    
-    SDL_Surface* surface = IMG_Load(filename.c_str());
+    // Decode straight from memory, the file has already been read by read_file_bytes
+    SDL_RWops* rw = SDL_RWFromConstMem(bytes.data(), static_cast<int>(bytes.size()));
+    SDL_Surface* surface = IMG_Load_RW(rw, 1);  // 1 = free the RWops for us
     if (!surface) {
         std::cerr << "IMG_Load failed: " << IMG_GetError() << std::endl;
         return {};
@@ -118,6 +152,10 @@ std::vector<double> ANN::load_image(const std::string& filename) {
     
     // std::cout << "Successfully loaded " << pixels.size() << " pixels with SDL2_image" << std::endl;
     return pixels;
+#else
+    std::cerr << "SDL2_image not available - cannot decode image" << std::endl;
+    return {};
+#endif
 }
 
 void ANN::normalise_image(std::vector<double>& image_data, double max_value) {
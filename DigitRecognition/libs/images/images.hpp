@@ -9,6 +9,22 @@ namespace ANN {
     //
     std::vector<double> load_image(const std::string& filename);
 
+    //
+    // Read the raw (still encoded) bytes of a file, empty on failure
+    //
+    std::vector<unsigned char> read_file_bytes(const std::string& filename);
+
+    //
+    // Start the image decoder (SDL) on the calling thread, call from the main thread before
+    // decoding on worker threads. False if images cannot be decoded. decode_image calls it too.
+    //
+    bool init_image_decoding();
+
+    //
+    // Decode an in-memory image file (png, bmp, jpg) into grayscale pixel values (0-255)
+    //
+    std::vector<double> decode_image(const std::vector<unsigned char>& bytes);
+
     //
     // Scale (normalise) the image data by dividing it by constant
     //
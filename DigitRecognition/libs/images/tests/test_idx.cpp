@@ -0,0 +1,115 @@
+#include "../idx.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+static void write_big_endian(std::ofstream& file, uint32_t value) {
+    const char bytes[4] = {char(value >> 24), char(value >> 16), char(value >> 8), char(value)};
+    file.write(bytes, sizeof(bytes));
+}
+
+// count images of rows × columns, pixel p of image n is (n * 31 + p) % 256. Short files stop early.
+static void write_idx(const std::string& filename, uint32_t count, uint32_t rows, uint32_t columns,
+                      uint32_t images_written, uint32_t magic = 0x00000803) {
+    std::ofstream file(filename, std::ios::binary);
+    write_big_endian(file, magic);
+    write_big_endian(file, count);
+    write_big_endian(file, rows);
+    write_big_endian(file, columns);
+    for (uint32_t n = 0; n < images_written; ++n) {
+        for (uint32_t p = 0; p < rows * columns; ++p) {
+            file.put(static_cast<char>((n * 31 + p) % 256));
+        }
+    }
+}
+
+template <typename Function>
+static bool throws(Function function) {
+    try {
+        function();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+bool test_read_images() {
+    std::cout << "Testing reading an IDX image file..." << std::endl;
+
+    const std::string filename = "test_idx_images.idx3-ubyte";
+    write_idx(filename, 5, 28, 28, 5);
+    ASSERT_TRUE(ANN::IdxImageReader::is_idx_image_file(filename));
+
+    ANN::IdxImageReader reader(filename);
+    ASSERT_TRUE(reader.count() == 5 && reader.rows() == 28 && reader.columns() == 28);
+    ASSERT_TRUE(reader.image_size() == 784);
+
+    std::vector<uint8_t> pixels(reader.image_size());
+    uint32_t images = 0;
+    while (reader.read(pixels.data())) {
+        for (uint32_t p = 0; p < 784; ++p) {
+            ASSERT_TRUE(pixels[p] == (images * 31 + p) % 256);
+        }
+        images++;
+    }
+    ASSERT_TRUE(images == 5);
+    ASSERT_TRUE(!reader.read(pixels.data()));
+
+    std::remove(filename.c_str());
+    std::cout << "✓ IDX read passed" << std::endl;
+    return true;
+}
+
+bool test_bad_files() {
+    std::cout << "Testing IDX errors..." << std::endl;
+
+    ASSERT_TRUE(!ANN::IdxImageReader::is_idx_image_file("no_such_file.idx3-ubyte"));
+    ASSERT_TRUE(throws([] { ANN::IdxImageReader reader("no_such_file.idx3-ubyte"); }));
+
+    // Labels file magic
+    const std::string labels = "test_idx_labels.idx1-ubyte";
+    write_idx(labels, 3, 4, 4, 3, 0x00000801);
+    ASSERT_TRUE(!ANN::IdxImageReader::is_idx_image_file(labels));
+    ASSERT_TRUE(throws([&] { ANN::IdxImageReader reader(labels); }));
+
+    // Header promises more images than the file holds
+    const std::string truncated = "test_idx_truncated.idx3-ubyte";
+    write_idx(truncated, 3, 4, 4, 2);
+    ANN::IdxImageReader reader(truncated);
+    std::vector<uint8_t> pixels(reader.image_size());
+    ASSERT_TRUE(reader.read(pixels.data()) && reader.read(pixels.data()));
+    ASSERT_TRUE(throws([&] { reader.read(pixels.data()); }));
+
+    std::remove(labels.c_str());
+    std::remove(truncated.c_str());
+    std::cout << "✓ IDX errors passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running IDX Reader Tests" << std::endl;
+    std::cout << "========================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_read_images();
+    all_passed &= test_bad_files();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
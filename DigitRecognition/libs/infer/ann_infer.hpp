@@ -0,0 +1,318 @@
+#pragma once
+
+//
+// Standalone inference for networks trained by DigitRecognition.
+// Header only, depends on nothing but the C++ standard library: no SDL, no JSON, no training code.
+//
+// Reads the weights file Network::save writes into one block of memory, either caller supplied
+// or allocated once by load(). After loading, classify() and infer() allocate nothing, throw
+// nothing and do no I/O, and a const Classifier can be shared between threads as long as each
+// passes its own Scratch. Errors are reported as a Status, never as exceptions.
+//
+//     ANN::Infer::Classifier classifier;
+//     if (classifier.load("DigitRecog_Best.bin") != ANN::Infer::Status::Ok) { ... }
+//     int digit = classifier.classify(pixels);    // 784 bytes, 0-255, row major
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+
+namespace ANN {
+namespace Infer {
+
+    enum class Status {
+        Ok,
+        OpenFailed,         // file could not be opened
+        NotAWeightsFile,    // wrong magic
+        UnsupportedVersion,
+        BadHeader,          // unknown activation or too few / too many / empty layers
+        Truncated,          // file ended before the last parameter
+        BufferTooSmall,     // caller's buffer is below required_doubles()
+        OutOfMemory
+    };
+
+    inline const char* status_message(Status status) {
+        switch (status) {
+            case Status::Ok: return "ok";
+            case Status::OpenFailed: return "could not open weights file";
+            case Status::NotAWeightsFile: return "not a weights file";
+            case Status::UnsupportedVersion: return "unsupported weights file version";
+            case Status::BadHeader: return "corrupt weights file header";
+            case Status::Truncated: return "truncated weights file";
+            case Status::BufferTooSmall: return "buffer too small for the network";
+            case Status::OutOfMemory: return "out of memory";
+        }
+        return "unknown error";
+    }
+
+    // Layers a Classifier can hold, sizes live in the object so loading needs no allocation of its own
+    inline constexpr size_t max_layer_sizes = 16;
+
+    //
+    // Loaded network. Parameters are laid out as in the weights file, each layer's weights
+    // (one row of inputs per output neuron) followed by its biases, with two activation
+    // buffers of the widest layer after them for single threaded use.
+    //
+    class Classifier {
+    public:
+        // Working memory for infer() from several threads, 2 × max_width() doubles
+        struct Scratch {
+            double* current;
+            double* next;
+        };
+
+        Classifier() = default;
+        Classifier(const Classifier&) = delete;
+        Classifier& operator=(const Classifier&) = delete;
+
+        // Allocate the one block the network needs and read the file into it
+        Status load(const char* filename) noexcept {
+            std::FILE* file = std::fopen(filename, "rb");
+            if (!file) {
+                return Status::OpenFailed;
+            }
+            FileSource source{file};
+            Status status = read_header(source);
+            if (status == Status::Ok) {
+                owned_.reset(new (std::nothrow) double[required_doubles()]);
+                status = owned_ ? read_parameters(source, owned_.get()) : Status::OutOfMemory;
+            }
+            std::fclose(file);
+            return finish(status);
+        }
+
+        // Read the file into the caller's buffer, which must hold required_doubles(filename)
+        Status load(const char* filename, std::span<double> buffer) noexcept {
+            std::FILE* file = std::fopen(filename, "rb");
+            if (!file) {
+                return Status::OpenFailed;
+            }
+            FileSource source{file};
+            Status status = read_header(source);
+            if (status == Status::Ok) {
+                status = buffer.size() < required_doubles() ? Status::BufferTooSmall : read_parameters(source, buffer.data());
+            }
+            std::fclose(file);
+            return finish(status);
+        }
+
+        // The weights file already in memory (e.g. linked into the binary), into the caller's buffer
+        Status load(std::span<const uint8_t> file_bytes, std::span<double> buffer) noexcept {
+            MemorySource source{file_bytes.data(), file_bytes.size()};
+            Status status = read_header(source);
+            if (status == Status::Ok) {
+                status = buffer.size() < required_doubles() ? Status::BufferTooSmall : read_parameters(source, buffer.data());
+            }
+            return finish(status);
+        }
+
+        // Doubles a buffer must hold for this weights file, 0 if its header cannot be read
+        static size_t required_doubles(const char* filename) noexcept {
+            Classifier probe;
+            std::FILE* file = std::fopen(filename, "rb");
+            if (!file) {
+                return 0;
+            }
+            FileSource source{file};
+            const Status status = probe.read_header(source);
+            std::fclose(file);
+            return status == Status::Ok ? probe.required_doubles() : 0;
+        }
+
+        bool loaded() const noexcept { return parameters_ != nullptr; }
+        size_t input_size() const noexcept { return layer_count_ > 0 ? sizes_[0] : 0; }
+        size_t output_size() const noexcept { return layer_count_ > 0 ? sizes_[layer_count_] : 0; }
+        size_t max_width() const noexcept { return max_width_; }
+        size_t layer_count() const noexcept { return layer_count_; }
+        bool relu() const noexcept { return relu_; }
+
+        // Byte pixels are divided by this, 255 for networks trained on normalised images (the default), 1 otherwise
+        void set_pixel_max(double max_value) noexcept { pixel_max_ = max_value; }
+
+        //
+        // Forward pass over input_size() values into outputs (output_size() values).
+        // The overloads without a Scratch use the buffers in the loaded block, so are not thread safe.
+        //
+        void infer(const double* inputs, double* outputs, Scratch scratch) const noexcept {
+            forward(inputs, outputs, scratch);
+        }
+        void infer(const uint8_t* pixels, double* outputs, Scratch scratch) const noexcept {
+            forward(convert(pixels, scratch), outputs, scratch);
+        }
+        void infer(const double* inputs, double* outputs) const noexcept {
+            infer(inputs, outputs, own_scratch());
+        }
+        void infer(const uint8_t* pixels, double* outputs) const noexcept {
+            infer(pixels, outputs, own_scratch());
+        }
+
+        // Predicted label, the largest output. pixels holds input_size() bytes.
+        int classify(const uint8_t* pixels) const noexcept {
+            return classify(pixels, own_scratch());
+        }
+        int classify(const uint8_t* pixels, Scratch scratch) const noexcept {
+            return largest(forward(convert(pixels, scratch), nullptr, scratch), output_size());
+        }
+        int classify(const double* inputs) const noexcept {
+            return largest(forward(inputs, nullptr, own_scratch()), output_size());
+        }
+
+    private:
+        struct FileSource {
+            std::FILE* file;
+            bool read(void* target, size_t bytes) { return std::fread(target, 1, bytes, file) == bytes; }
+        };
+
+        struct MemorySource {
+            const uint8_t* data;
+            size_t remaining;
+            bool read(void* target, size_t bytes) {
+                if (bytes > remaining) {
+                    return false;
+                }
+                std::memcpy(target, data, bytes);
+                data += bytes;
+                remaining -= bytes;
+                return true;
+            }
+        };
+
+        // Same header as Network::write_weights_header
+        template <typename Source>
+        Status read_header(Source& source) noexcept {
+            parameters_ = nullptr;
+            layer_count_ = 0;
+
+            char magic[4];
+            uint32_t version = 0;
+            if (!source.read(magic, sizeof(magic)) || std::memcmp(magic, "ANNW", 4) != 0) {
+                return Status::NotAWeightsFile;
+            }
+            if (!source.read(&version, sizeof(version)) || version != 1) {
+                return Status::UnsupportedVersion;
+            }
+
+            uint32_t name_length = 0;
+            char name[8] = {};
+            if (!source.read(&name_length, sizeof(name_length)) || name_length >= sizeof(name)
+                || !source.read(name, name_length)) {
+                return Status::BadHeader;
+            }
+            if (std::strcmp(name, "relu") == 0) {
+                relu_ = true;
+            } else if (std::strcmp(name, "sigmoid") == 0) {
+                relu_ = false;
+            } else {
+                return Status::BadHeader;
+            }
+
+            uint32_t size_count = 0;
+            if (!source.read(&size_count, sizeof(size_count)) || size_count < 3 || size_count > max_layer_sizes) {
+                return Status::BadHeader;
+            }
+            max_width_ = 0;
+            parameter_count_ = 0;
+            for (uint32_t i = 0; i < size_count; ++i) {
+                uint32_t size = 0;
+                if (!source.read(&size, sizeof(size)) || size == 0 || size > (1u << 24)) {
+                    return Status::BadHeader;
+                }
+                sizes_[i] = size;
+                max_width_ = std::max<size_t>(max_width_, size);
+                if (i > 0) {
+                    parameter_count_ += sizes_[i - 1] * sizes_[i] + sizes_[i];
+                }
+            }
+            layer_count_ = size_count - 1;
+            return Status::Ok;
+        }
+
+        template <typename Source>
+        Status read_parameters(Source& source, double* block) noexcept {
+            if (!source.read(block, parameter_count_ * sizeof(double))) {
+                return Status::Truncated;
+            }
+            parameters_ = block;
+            return Status::Ok;
+        }
+
+        Status finish(Status status) noexcept {
+            if (status != Status::Ok) {
+                parameters_ = nullptr;
+                layer_count_ = 0;
+            }
+            return status;
+        }
+
+        size_t required_doubles() const noexcept { return parameter_count_ + 2 * max_width_; }
+
+        Scratch own_scratch() const noexcept {
+            double* scratch = parameters_ + parameter_count_;
+            return {scratch, scratch + max_width_};
+        }
+
+        // Pixels to doubles as normalise_image does, into the buffer the first layer does not write
+        const double* convert(const uint8_t* pixels, Scratch scratch) const noexcept {
+            for (size_t i = 0; i < input_size(); ++i) {
+                scratch.next[i] = pixels[i] / pixel_max_;
+            }
+            return scratch.next;
+        }
+
+        //
+        // Layer i writes scratch.current when i is even and scratch.next when odd, reading the other,
+        // so inputs may sit in scratch.next. The last layer writes outputs unless that is nullptr.
+        // Summation order is that of Layer, results match Network::predict_probabilities exactly.
+        //
+        const double* forward(const double* inputs, double* outputs, Scratch scratch) const noexcept {
+            const double* weights = parameters_;
+            const double* current = inputs;
+
+            for (size_t layer = 0; layer < layer_count_; ++layer) {
+                const size_t in = sizes_[layer];
+                const size_t out = sizes_[layer + 1];
+                const double* biases = weights + in * out;
+                double* target = layer % 2 == 0 ? scratch.current : scratch.next;
+                if (outputs && layer + 1 == layer_count_) {
+                    target = outputs;
+                }
+
+                for (size_t o = 0; o < out; ++o) {
+                    const double* row = weights + o * in;
+                    double sum = 0.0;
+                    for (size_t i = 0; i < in; ++i) {
+                        sum += current[i] * row[i];
+                    }
+                    const double z = sum + biases[o];
+                    target[o] = relu_ ? std::max(0.0, z) : 1.0 / (1.0 + std::exp(-z));
+                }
+
+                weights = biases + out;
+                current = target;
+            }
+            return current;
+        }
+
+        static int largest(const double* values, size_t count) noexcept {
+            return static_cast<int>(std::max_element(values, values + count) - values);
+        }
+
+        std::unique_ptr<double[]> owned_;
+        double* parameters_ = nullptr;
+        size_t sizes_[max_layer_sizes] = {};
+        size_t layer_count_ = 0;
+        size_t parameter_count_ = 0;
+        size_t max_width_ = 0;
+        bool relu_ = false;
+        double pixel_max_ = 255.0;
+    };
+
+} // namespace Infer
+} // namespace ANN
@@ -0,0 +1,196 @@
+#include "../ann_infer.hpp"
+#include "../../networks/networks.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+// Every heap allocation in the process, to check the inference loop makes none.
+// The array and nothrow forms of new call this one. GCC takes the malloc/free pairing for a mismatch.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+static std::atomic<size_t> allocations{0};
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+static ANN::Network make_network(const std::vector<int>& layers, const std::string& activation, uint64_t seed) {
+    ANN::WeightInitConfig weight_config;
+    weight_config.method = "uniform";
+    weight_config.range = {-0.2, 0.2};
+    weight_config.seed = seed;
+    return ANN::Network(layers, weight_config, ANN::LearningRateConfig{}, activation);
+}
+
+// Digit sized images with a stroke of varying brightness
+static std::vector<std::vector<uint8_t>> make_images(size_t count) {
+    std::vector<std::vector<uint8_t>> images(count, std::vector<uint8_t>(784, 0));
+    for (size_t n = 0; n < count; ++n) {
+        for (size_t p = 0; p < 784; ++p) {
+            if ((p * 7 + n * 13) % 11 < 3) {
+                images[n][p] = static_cast<uint8_t>((p * 31 + n * 17) % 256);
+            }
+        }
+    }
+    return images;
+}
+
+static std::vector<double> normalised(const std::vector<uint8_t>& image) {
+    std::vector<double> values(image.begin(), image.end());
+    for (double& value : values) {
+        value /= 255;
+    }
+    return values;
+}
+
+static std::vector<uint8_t> read_bytes(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+bool test_matches_network(const std::string& activation) {
+    std::cout << "Testing outputs match Network (" << activation << ")..." << std::endl;
+
+    const std::string filename = "test_ann_infer_" + activation + ".bin";
+    ANN::Network network = make_network({784, 48, 24, 10}, activation, 5);
+    ASSERT_TRUE(network.save(filename));
+
+    ANN::Infer::Classifier classifier;
+    ASSERT_TRUE(classifier.load(filename.c_str()) == ANN::Infer::Status::Ok);
+    ASSERT_TRUE(classifier.input_size() == 784 && classifier.output_size() == 10 && classifier.layer_count() == 3);
+    ASSERT_TRUE(classifier.relu() == (activation == "relu"));
+
+    // The same file through a caller's buffer and from memory
+    std::vector<double> buffer(ANN::Infer::Classifier::required_doubles(filename.c_str()));
+    ANN::Infer::Classifier external;
+    ASSERT_TRUE(external.load(filename.c_str(), buffer) == ANN::Infer::Status::Ok);
+    auto bytes = read_bytes(filename);
+    std::vector<double> memory_buffer(buffer.size());
+    ANN::Infer::Classifier from_memory;
+    ASSERT_TRUE(from_memory.load(bytes, memory_buffer) == ANN::Infer::Status::Ok);
+
+    auto images = make_images(20);
+    std::vector<double> outputs(10);
+    std::vector<double> scratch_memory(2 * classifier.max_width());
+    ANN::Infer::Classifier::Scratch scratch{scratch_memory.data(), scratch_memory.data() + classifier.max_width()};
+    for (const auto& image : images) {
+        auto expected = network.predict_probabilities(normalised(image));
+        classifier.infer(image.data(), outputs.data(), scratch);
+        for (size_t o = 0; o < 10; ++o) {
+            ASSERT_NEAR(outputs[o], expected[o], 0.0);
+        }
+        const int label = network.predict_label(normalised(image));
+        ASSERT_TRUE(classifier.classify(image.data()) == label);
+        ASSERT_TRUE(external.classify(image.data()) == label);
+        ASSERT_TRUE(from_memory.classify(image.data()) == label);
+        ASSERT_TRUE(classifier.classify(normalised(image).data()) == label);
+    }
+
+    std::remove(filename.c_str());
+    std::cout << "✓ Network match (" << activation << ") passed" << std::endl;
+    return true;
+}
+
+bool test_no_allocation() {
+    std::cout << "Testing classify allocates nothing..." << std::endl;
+
+    const std::string filename = "test_ann_infer_alloc.bin";
+    ASSERT_TRUE(make_network({784, 32, 10}, "sigmoid", 9).save(filename));
+    ANN::Infer::Classifier classifier;
+    ASSERT_TRUE(classifier.load(filename.c_str()) == ANN::Infer::Status::Ok);
+    auto images = make_images(50);
+
+    const size_t before = allocations.load();
+    int checksum = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (const auto& image : images) {
+            checksum += classifier.classify(image.data());
+        }
+    }
+    ASSERT_TRUE(allocations.load() == before);
+    ASSERT_TRUE(checksum >= 0);
+
+    std::remove(filename.c_str());
+    std::cout << "✓ No allocation passed" << std::endl;
+    return true;
+}
+
+bool test_errors() {
+    std::cout << "Testing load errors..." << std::endl;
+
+    ANN::Infer::Classifier classifier;
+    ASSERT_TRUE(classifier.load("no_such_weights_file.bin") == ANN::Infer::Status::OpenFailed);
+    ASSERT_TRUE(!classifier.loaded());
+
+    const std::string filename = "test_ann_infer_errors.bin";
+    ASSERT_TRUE(make_network({784, 16, 10}, "relu", 3).save(filename));
+    auto bytes = read_bytes(filename);
+    std::vector<double> buffer(ANN::Infer::Classifier::required_doubles(filename.c_str()));
+    ASSERT_TRUE(buffer.size() == 784 * 16 + 16 + 16 * 10 + 10 + 2 * 784);
+
+    auto truncated = std::span<const uint8_t>(bytes).first(bytes.size() - 8);
+    ASSERT_TRUE(classifier.load(truncated, buffer) == ANN::Infer::Status::Truncated);
+    ASSERT_TRUE(!classifier.loaded());
+
+    ASSERT_TRUE(classifier.load(bytes, std::span<double>(buffer).first(buffer.size() - 1)) == ANN::Infer::Status::BufferTooSmall);
+
+    auto bad_magic = bytes;
+    bad_magic[0] = 'X';
+    ASSERT_TRUE(classifier.load(bad_magic, buffer) == ANN::Infer::Status::NotAWeightsFile);
+
+    ASSERT_TRUE(classifier.load(bytes, buffer) == ANN::Infer::Status::Ok);
+    ASSERT_TRUE(classifier.loaded());
+
+    std::remove(filename.c_str());
+    std::cout << "✓ Load errors passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Embedded Inference Tests" << std::endl;
+    std::cout << "================================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_matches_network("sigmoid");
+    all_passed &= test_matches_network("relu");
+    all_passed &= test_no_allocation();
+    all_passed &= test_errors();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,77 @@
+#include "../layers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+//
+// Input gradient (step E of Layer::backward) timings, the row order kernel against the
+// original strided one, over the layer shapes we train.
+// Usage: bench_backward [iterations scale, default 1]
+//
+
+namespace {
+
+    // Average microseconds per call of kernel over minimum_calls calls
+    template <typename Kernel>
+    double time_kernel(Kernel kernel, int minimum_calls, double& checksum) {
+        using Clock = std::chrono::steady_clock;
+
+        // Warm the caches and the branch predictors first
+        checksum += kernel()[0];
+
+        int calls = 0;
+        auto start = Clock::now();
+        while (calls < minimum_calls) {
+            checksum += kernel()[0];
+            calls++;
+        }
+        double elapsed_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        return elapsed_us / calls;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const int scale = argc > 1 ? std::max(1, std::stoi(argv[1])) : 1;
+
+    const std::vector<std::pair<int, int>> shapes = {
+        {784, 512}, {784, 128}, {512, 256}, {256, 128}, {128, 64}, {64, 10}
+    };
+
+    ANN::WeightInitConfig config;
+    config.seed = 1;
+
+    std::cout << "Input gradient kernel, microseconds per call\n";
+    std::cout << std::setw(12) << "shape" << std::setw(12) << "strided" << std::setw(12) << "row order"
+              << std::setw(10) << "speedup" << "\n";
+
+    double checksum = 0.0;
+    for (auto [inputs, outputs] : shapes) {
+        ANN::Layer layer(inputs, outputs, config);
+        std::vector<double> deltas(outputs);
+        for (int o = 0; o < outputs; ++o) {
+            deltas[o] = 0.001 * (o % 7 - 3);
+        }
+
+        // Roughly the same amount of work per shape
+        const int calls = scale * std::max(20, 20000000 / (inputs * outputs));
+
+        double strided = time_kernel([&] { return layer.compute_input_gradients_strided(deltas); }, calls, checksum);
+        double row_order = time_kernel([&] { return layer.compute_input_gradients(deltas); }, calls, checksum);
+
+        std::string shape = std::to_string(inputs) + "x" + std::to_string(outputs);
+        std::cout << std::setw(12) << shape
+                  << std::setw(12) << std::fixed << std::setprecision(2) << strided
+                  << std::setw(12) << std::fixed << std::setprecision(2) << row_order
+                  << std::setw(9) << std::fixed << std::setprecision(2) << strided / row_order << "x\n";
+    }
+
+    // Keeps the kernels from being optimised away
+    std::cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "half_precision.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ANN_HALF_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ANN {
+namespace Half {
+
+namespace {
+
+#if ANN_HALF_X86
+
+    __attribute__((target("avx,f16c")))
+    void encode_fp16_f16c(const double* values, uint16_t* encoded, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128 low = _mm256_cvtpd_ps(_mm256_loadu_pd(values + i));
+            const __m128 high = _mm256_cvtpd_ps(_mm256_loadu_pd(values + i + 4));
+            const __m256 floats = _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(encoded + i), _mm256_cvtps_ph(floats, _MM_FROUND_TO_NEAREST_INT));
+        }
+        for (; i < count; ++i) {
+            encoded[i] = float_to_fp16(static_cast<float>(values[i]));
+        }
+    }
+
+    __attribute__((target("avx,f16c")))
+    void decode_fp16_f16c(const uint16_t* encoded, float* values, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(encoded + i));
+            _mm256_storeu_ps(values + i, _mm256_cvtph_ps(halves));
+        }
+        for (; i < count; ++i) {
+            values[i] = fp16_to_float(encoded[i]);
+        }
+    }
+
+    __attribute__((target("avx512f,avx512vl,avx512bf16")))
+    void encode_bf16_avx512(const double* values, uint16_t* encoded, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128 low = _mm256_cvtpd_ps(_mm256_loadu_pd(values + i));
+            const __m128 high = _mm256_cvtpd_ps(_mm256_loadu_pd(values + i + 4));
+            const __m256 floats = _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(encoded + i), reinterpret_cast<__m128i>(_mm256_cvtneps_pbh(floats)));
+        }
+        for (; i < count; ++i) {
+            encoded[i] = float_to_bf16(static_cast<float>(values[i]));
+        }
+    }
+
+#endif
+
+    struct CpuFeatures {
+        bool f16c = false;
+        bool bf16 = false;
+
+        CpuFeatures() {
+#if ANN_HALF_X86
+            __builtin_cpu_init();
+            f16c = __builtin_cpu_supports("f16c") && __builtin_cpu_supports("avx");
+            bf16 = __builtin_cpu_supports("avx512bf16") && __builtin_cpu_supports("avx512vl");
+#endif
+        }
+    };
+
+    const CpuFeatures& cpu_features() {
+        static const CpuFeatures features;
+        return features;
+    }
+
+} // namespace
+
+bool hardware_fp16() {
+    return cpu_features().f16c;
+}
+
+bool hardware_bf16() {
+    return cpu_features().bf16;
+}
+
+void encode(const double* values, uint16_t* encoded, std::size_t count, Precision precision) {
+#if ANN_HALF_X86
+    if (precision == Precision::Float16 && hardware_fp16()) {
+        encode_fp16_f16c(values, encoded, count);
+        return;
+    }
+    if (precision == Precision::BFloat16 && hardware_bf16()) {
+        encode_bf16_avx512(values, encoded, count);
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < count; ++i) {
+        const float value = static_cast<float>(values[i]);
+        encoded[i] = precision == Precision::Float16 ? float_to_fp16(value) : float_to_bf16(value);
+    }
+}
+
+void decode(const uint16_t* encoded, float* values, std::size_t count, Precision precision) {
+    if (precision == Precision::BFloat16) {
+        // Just a shift, the compiler vectorises it
+        for (std::size_t i = 0; i < count; ++i) {
+            values[i] = bf16_to_float(encoded[i]);
+        }
+        return;
+    }
+#if ANN_HALF_X86
+    if (hardware_fp16()) {
+        decode_fp16_f16c(encoded, values, count);
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < count; ++i) {
+        values[i] = fp16_to_float(encoded[i]);
+    }
+}
+
+} // namespace Half
+} // namespace ANN
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace ANN {
+
+    // Storage precision of the weights Layer::infer_batch reads
+    enum class Precision {
+        Double,     // the training weights themselves
+        Float16,    // IEEE half, 10 bit mantissa, range to 65504
+        BFloat16    // top half of a float, 7 bit mantissa, full float range
+    };
+
+    // "double", "float16" or "bfloat16"
+    inline std::optional<Precision> parse_precision(const std::string& name) {
+        if (name == "double") return Precision::Double;
+        if (name == "float16") return Precision::Float16;
+        if (name == "bfloat16") return Precision::BFloat16;
+        return std::nullopt;
+    }
+
+    inline const char* precision_name(Precision precision) {
+        switch (precision) {
+            case Precision::Float16: return "float16";
+            case Precision::BFloat16: return "bfloat16";
+            default: return "double";
+        }
+    }
+
+namespace Half {
+
+    //
+    // Scalar conversions, round to nearest even. These are the reference the bulk
+    // conversions fall back to when the CPU has no F16C / AVX-512 BF16.
+    //
+    inline uint16_t float_to_bf16(float value) {
+        uint32_t bits = std::bit_cast<uint32_t>(value);
+        if ((bits & 0x7fffffff) > 0x7f800000) {
+            return static_cast<uint16_t>((bits >> 16) | 0x40);  // keep NaN a quiet NaN
+        }
+        bits += 0x7fff + ((bits >> 16) & 1);
+        return static_cast<uint16_t>(bits >> 16);
+    }
+
+    inline float bf16_to_float(uint16_t value) {
+        return std::bit_cast<float>(static_cast<uint32_t>(value) << 16);
+    }
+
+    inline uint16_t float_to_fp16(float value) {
+        constexpr uint32_t float_infinity = 255u << 23;
+        constexpr uint32_t half_overflow = (127u + 16) << 23;                   // 65536, rounds to infinity
+        constexpr uint32_t denormal_magic = ((127u - 15) + (23 - 10) + 1) << 23;
+
+        uint32_t bits = std::bit_cast<uint32_t>(value);
+        const uint32_t sign = bits & 0x80000000u;
+        bits ^= sign;
+
+        uint32_t half;
+        if (bits >= half_overflow) {
+            half = bits > float_infinity ? 0x7e00 : 0x7c00;
+        } else if (bits < (113u << 23)) {
+            // Below the smallest normal half, let the float adder do the rounding into a denormal
+            float shifted = std::bit_cast<float>(bits) + std::bit_cast<float>(denormal_magic);
+            half = std::bit_cast<uint32_t>(shifted) - denormal_magic;
+        } else {
+            const uint32_t mantissa_odd = (bits >> 13) & 1;
+            bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xfff;
+            bits += mantissa_odd;
+            half = bits >> 13;
+        }
+        return static_cast<uint16_t>(half | (sign >> 16));
+    }
+
+    inline float fp16_to_float(uint16_t value) {
+        constexpr uint32_t shifted_exponent = 0x7c00u << 13;
+
+        uint32_t bits = (value & 0x7fffu) << 13;
+        const uint32_t exponent = bits & shifted_exponent;
+        bits += (127u - 15) << 23;
+
+        if (exponent == shifted_exponent) {
+            bits += (128u - 16) << 23;      // infinity or NaN
+        } else if (exponent == 0) {
+            bits += 1u << 23;               // denormal, renormalise
+            bits = std::bit_cast<uint32_t>(std::bit_cast<float>(bits) - std::bit_cast<float>(113u << 23));
+        }
+        return std::bit_cast<float>(bits | (static_cast<uint32_t>(value & 0x8000u) << 16));
+    }
+
+    //
+    // Bulk conversions, F16C / AVX-512 BF16 when the CPU has them (checked once at run time),
+    // the scalar functions above otherwise. Values go through float on the way.
+    // The BF16 instructions flush float denormals to zero, the only difference to the fallback.
+    //
+    void encode(const double* values, uint16_t* encoded, std::size_t count, Precision precision);
+    void decode(const uint16_t* encoded, float* values, std::size_t count, Precision precision);
+
+    bool hardware_fp16();
+    bool hardware_bf16();
+
+    // Float dot product with float accumulation, eight partial sums so the loop vectorises
+    inline float dot(const float* a, const float* b, std::size_t count) {
+        float lanes[8] = {};
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            for (std::size_t lane = 0; lane < 8; ++lane) {
+                lanes[lane] += a[i + lane] * b[i + lane];
+            }
+        }
+        float sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+        for (; i < count; ++i) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+} // namespace Half
+} // namespace ANN
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "../activations/activations.h"
+#include "../random/philox.hpp"
+#include "parameter_arena.hpp"
+#include "half_precision.hpp"
 
 #include <iostream>
 #include <functional>
@@ -11,12 +14,20 @@
 #include <random>
 #include <iomanip>
 #include <cmath>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <algorithm>
+#include <stdexcept>
 
 namespace ANN {
 
     struct WeightInitConfig {
         std::string method = "uniform";
         std::vector<double> range = {-1.0, 1.0};
+        std::optional<uint64_t> seed;   // same seed, same weights; unset draws one from std::random_device
+        uint64_t stream = 0;            // independent sequence per layer under one seed
+        unsigned int threads = 0;       // init threads for wide layers, 0 = one per hardware thread
     };
 
     class Layer {
@@ -26,115 +37,287 @@ namespace ANN {
               const std::string& activation = "sigmoid")
             : inputs_(input_size, 0.0)
             , outputs_(output_size, 0.0)
-            , weights_(input_size * output_size, 0.0) // flat vector to hold weights, think of me as a 2d array, this is where the learning is recorded    
-            , biases_(output_size, 0.0)
             , pre_activations_(output_size, 0.0)  // Initialize pre-activation storage
-            , weight_gradients_(input_size * output_size, 0.0)  // Initialize gradient storage
-            , bias_gradients_(output_size, 0.0)
             , activation_function(ANN::get_activation(activation))  // Set from parameter
-            , activation_derivative(activation == "relu" ? ANN::relu_derivative : ANN::sigmoid_derivative)  // Set from parameter
+            , activation_derivative(ANN::get_activation_derivative(activation))  // Set from parameter
+            , output_derivative(ANN::get_activation_output_derivative(activation))
         {
+            // A standalone layer keeps its parameters in an arena of its own,
+            // a Network moves them into one shared arena afterwards
+            bind_parameters(std::make_shared<ParameterArena>(parameter_capacity()));
+
             //
             // Initialize weights using specified method
             //
             initialize_weights(weight_config, input_size, output_size);
         }
 
+        // A copy gets its own parameters, never a view of the original's
+        Layer(const Layer& other)
+            : inputs_(other.inputs_)
+            , weights_(other.weights_)
+            , biases_(other.biases_)
+            , pre_activations_(other.pre_activations_)
+            , outputs_(other.outputs_)
+            , weight_gradients_(other.weight_gradients_)
+            , bias_gradients_(other.bias_gradients_)
+            , previous_layer(other.previous_layer)
+            , next_layer(other.next_layer)
+            , activation_function(other.activation_function)
+            , activation_derivative(other.activation_derivative)
+            , output_derivative(other.output_derivative)
+            , inference_mode_(other.inference_mode_)
+            , sparse_threshold_(other.sparse_threshold_)
+            , sparse_active_(other.sparse_active_)
+            , active_inputs_(other.active_inputs_)
+            , inference_precision_(other.inference_precision_)
+            , compact_weights_(other.compact_weights_)
+            , compact_biases_(other.compact_biases_)
+        {
+            bind_parameters(std::make_shared<ParameterArena>(parameter_capacity()));
+        }
+
+        Layer& operator=(const Layer& other) {
+            if (this != &other) {
+                Layer copy(other);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        // Moving keeps the views, the arena memory itself never moves
+        Layer(Layer&&) = default;
+        Layer& operator=(Layer&&) = default;
+
         ~Layer() = default;
-        
 
-        // TODO move this to its own util module
+        // Doubles this layer needs in an arena, weights and biases each start on a cache line
+        size_t parameter_capacity() const {
+            return ParameterArena::aligned_size(inputs_.size() * outputs_.size()) + ParameterArena::aligned_size(outputs_.size());
+        }
+
+        //
+        // Take space for this layer's weights and biases (and their gradients) in arena and carry the
+        // current values over, the views then point into the arena.
+        //
+        void bind_parameters(std::shared_ptr<ParameterArena> arena)
+        {
+            const size_t weight_count = inputs_.size() * outputs_.size();
+            const size_t bias_count = outputs_.size();
+            const size_t weight_offset = arena->reserve(weight_count);
+            const size_t bias_offset = arena->reserve(bias_count);
+
+            auto weights = arena->parameters(weight_offset, weight_count);
+            auto biases = arena->parameters(bias_offset, bias_count);
+            auto weight_gradients = arena->gradients(weight_offset, weight_count);
+            auto bias_gradients = arena->gradients(bias_offset, bias_count);
+
+            // Nothing to carry over on the first bind, the views are still empty
+            std::ranges::copy(weights_, weights.begin());
+            std::ranges::copy(biases_, biases.begin());
+            if (arena->has_gradients() && !weight_gradients_.empty()) {
+                std::ranges::copy(weight_gradients_, weight_gradients.begin());
+                std::ranges::copy(bias_gradients_, bias_gradients.begin());
+            }
+
+            weights_ = weights;
+            biases_ = biases;
+            weight_gradients_ = weight_gradients;
+            bias_gradients_ = bias_gradients;
+            arena_ = std::move(arena);
+        }
+
+
+        //
+        // Weights come from a counter based generator, weight i is a function of (seed, stream, i) only,
+        // so the fill can be split over threads and still reproduce exactly for a given seed.
+        //
         void initialize_weights(const WeightInitConfig& config, int input_size, int output_size)
         {
-            std::mt19937 rng(std::random_device{}());
-            
+            const uint64_t seed = config.seed ? *config.seed
+                                              : (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+            const Random::CounterRng rng(seed, config.stream);
+
+            auto fill_uniform = [&](double min_val, double max_val) {
+                Random::parallel_fill(weights_.data(), weights_.size(), [&](size_t i) {
+                    return min_val + (max_val - min_val) * rng.uniform(i);
+                }, config.threads);
+            };
+            auto fill_normal = [&](double mean, double std_dev) {
+                Random::parallel_fill(weights_.data(), weights_.size(), [&](size_t i) {
+                    return mean + std_dev * rng.normal(i);
+                }, config.threads);
+            };
+
             if (config.method == "uniform") {
-                double min_val = config.range[0];
-                double max_val = config.range[1];
-                std::uniform_real_distribution<double> dist(min_val, max_val);
-                for(auto& w : weights_) {
-                    w = dist(rng);
-                }
+                fill_uniform(config.range[0], config.range[1]);
             }
             else if (config.method == "normal") {
                 // Use range as [mean, std_dev]
                 double mean = config.range.size() > 0 ? config.range[0] : 0.0;
                 double std_dev = config.range.size() > 1 ? config.range[1] : 1.0;
-                std::normal_distribution<double> dist(mean, std_dev);
-                for(auto& w : weights_) {
-                    w = dist(rng);
-                }
+                fill_normal(mean, std_dev);
             }
             else if (config.method == "xavier") {
                 // Xavier/Glorot initialization: weights ~ U(-sqrt(6/(fan_in + fan_out)), sqrt(6/(fan_in + fan_out)))
                 double limit = std::sqrt(6.0 / (input_size + output_size));
-                std::uniform_real_distribution<double> dist(-limit, limit);
-                for(auto& w : weights_) {
-                    w = dist(rng);
-                }
+                fill_uniform(-limit, limit);
             }
             else if (config.method == "he") {
                 // He initialization: weights ~ N(0, sqrt(2/fan_in))
                 double std_dev = std::sqrt(2.0 / input_size);
-                std::normal_distribution<double> dist(0.0, std_dev);
-                for(auto& w : weights_) {
-                    w = dist(rng);
-                }
+                fill_normal(0.0, std_dev);
             }
             else {
                 // Default to uniform if method not recognized
-                std::uniform_real_distribution<double> dist(config.range[0], config.range[1]);
-                for(auto& w : weights_) {
-                    w = dist(rng);
-                }
+                fill_uniform(config.range[0], config.range[1]);
             }
         }
 
         std::vector<double> forward()
         {
             //
-            // Reset both pre-activations and outputs
+            // calculate my outputs, in inference mode z goes straight into outputs_ and is activated in place
             //
-            pre_activations_.assign(pre_activations_.size(), 0.0);
-            outputs_.assign(outputs_.size(), 0.0);
+            double* pre_activations = inference_mode_ ? outputs_.data() : pre_activations_.data();
+            if (use_sparse_inputs()) {
+                compute_pre_activations_sparse(inputs_.data(), active_inputs_, pre_activations);
+            } else {
+                compute_pre_activations(inputs_.data(), pre_activations);
+            }
 
-            //
-            // calculate my outputs
-            //
-            for(auto output_index = 0; output_index< outputs_.size(); output_index++) {
+            for(size_t output_index = 0; output_index < outputs_.size(); output_index++) {
+                outputs_[output_index] = activation_function(pre_activations[output_index]);
+            }
 
-                for(auto input_index = 0; input_index < inputs_.size(); input_index++) 
-                {
-                    auto input_times_weight = inputs_[input_index] * weights_[input_index + (output_index * inputs_.size())];
-                    pre_activations_[output_index] += input_times_weight;   
+            return outputs_;
+        }
+
+        //
+        // Forward pass for a batch of samples without touching the layer state, so one layer can be
+        // shared by several inference threads. inputs is [batch][input_size], outputs is [batch][output_size].
+        // Each weight row is reused for every sample in the batch while it is still in cache.
+        // scratch only serves the compact precisions, it grows to fit and is reused from call to call.
+        //
+        void infer_batch(const double* inputs, size_t batch_size, double* outputs, std::vector<float>& scratch) const
+        {
+            if (inference_precision_ != Precision::Double) {
+                infer_batch_compact(inputs, batch_size, outputs, scratch);
+                return;
+            }
+
+            const size_t input_size = inputs_.size();
+            const size_t output_size = outputs_.size();
+
+            for (size_t output_index = 0; output_index < output_size; ++output_index) {
+                const double* weight_row = &weights_[output_index * input_size];
+
+                for (size_t sample = 0; sample < batch_size; ++sample) {
+                    const double* input = inputs + sample * input_size;
+
+                    double sum = 0.0;
+                    for (size_t input_index = 0; input_index < input_size; ++input_index) {
+                        sum += input[input_index] * weight_row[input_index];
+                    }
+                    outputs[sample * output_size + output_index] = activation_function(sum + biases_[output_index]);
                 }
-                
-                pre_activations_[output_index] += biases_[output_index];
-                outputs_[output_index] = activation_function(pre_activations_[output_index]);
             }
+        }
 
-            return outputs_;
+        //
+        // Keep a float16 or bfloat16 copy of the weights (and float biases) for infer_batch, a quarter of
+        // the bytes of the double weights, with the dot products accumulated in float.
+        // The double weights stay the master copy that training updates. The copy is a snapshot,
+        // set it again after the weights change. Precision::Double drops it.
+        //
+        void set_inference_precision(Precision precision)
+        {
+            inference_precision_ = precision;
+            if (precision == Precision::Double) {
+                compact_weights_ = {};
+                compact_biases_ = {};
+                return;
+            }
+
+            compact_weights_.resize(weights_.size());
+            Half::encode(weights_.data(), compact_weights_.data(), weights_.size(), precision);
+            compact_biases_.assign(biases_.begin(), biases_.end());
         }
 
-        std::vector<double> backward(const std::vector<double>& loss_gradients)
+        Precision inference_precision() const { return inference_precision_; }
+
+        // Replace the activation and its derivative, e.g. with a faster approximation of the same function.
+        // output_derivative gives the derivative from the output, leave it empty if it needs the input.
+        void set_activation(ActivationFunction function, ActivationFunction derivative, ActivationFunction output_derivative_function = {})
         {
-            // A. Compute activation function derivatives using the stored pre-activation values
-            std::vector<double> activation_gradients(outputs_.size());
-            for (size_t i = 0; i < outputs_.size(); ++i) {
-                activation_gradients[i] = activation_derivative(pre_activations_[i]);
+            activation_function = std::move(function);
+            activation_derivative = std::move(derivative);
+            output_derivative = std::move(output_derivative_function);
+        }
+
+        //
+        // Inference mode keeps no pre-activations: forward() writes z into outputs_ and activates it
+        // in place, and the pre-activation buffer is released. Training still works if the
+        // activation's derivative can be taken from its output, otherwise backward() throws.
+        //
+        void set_inference_mode(bool enabled)
+        {
+            inference_mode_ = enabled;
+            if (enabled) {
+                pre_activations_ = {};
+            } else {
+                pre_activations_.assign(outputs_.size(), 0.0);
             }
-            
-            // B. Compute error terms (δ = ∂Loss/∂z = ∂Loss/∂output × ∂output/∂z)
-            std::vector<double> deltas(outputs_.size());
-            for (size_t i = 0; i < outputs_.size(); ++i) {
-                deltas[i] = loss_gradients[i] * activation_gradients[i];
+        }
+
+        bool inference_mode() const { return inference_mode_; }
+
+        //
+        // infer_batch over the compact weights, each row is widened to float once per batch.
+        // scratch holds the batch's inputs as float followed by the current weight row.
+        //
+        void infer_batch_compact(const double* inputs, size_t batch_size, double* outputs, std::vector<float>& scratch) const
+        {
+            const size_t input_size = inputs_.size();
+            const size_t output_size = outputs_.size();
+
+            scratch.resize((batch_size + 1) * input_size);
+            std::copy(inputs, inputs + batch_size * input_size, scratch.begin());
+            const float* input_values = scratch.data();
+            float* weight_row = scratch.data() + batch_size * input_size;
+
+            for (size_t output_index = 0; output_index < output_size; ++output_index) {
+                Half::decode(&compact_weights_[output_index * input_size], weight_row, input_size, inference_precision_);
+
+                for (size_t sample = 0; sample < batch_size; ++sample) {
+                    float sum = Half::dot(&input_values[sample * input_size], weight_row, input_size);
+                    outputs[sample * output_size + output_index] = activation_function(sum + compact_biases_[output_index]);
+                }
             }
+        }
+
+        std::vector<double> backward(const std::vector<double>& loss_gradients)
+        {
+            // A. and B. error terms for each output neuron
+            std::vector<double> deltas = compute_deltas(loss_gradients);
             
             // C. Compute weight gradients (∂Loss/∂weight = input × delta)
-            for (size_t output_idx = 0; output_idx < outputs_.size(); ++output_idx) {
-                for (size_t input_idx = 0; input_idx < inputs_.size(); ++input_idx) {
-                    size_t weight_idx = input_idx + (output_idx * inputs_.size());
-                    weight_gradients_[weight_idx] = inputs_[input_idx] * deltas[output_idx];
+            if (sparse_active_) {
+                // Zero inputs give zero gradients, only the active columns need a multiply
+                const size_t input_size = inputs_.size();
+                for (size_t output_idx = 0; output_idx < outputs_.size(); ++output_idx) {
+                    double* gradient_row = &weight_gradients_[output_idx * input_size];
+                    std::fill(gradient_row, gradient_row + input_size, 0.0);
+                    for (size_t input_idx : active_inputs_) {
+                        gradient_row[input_idx] = inputs_[input_idx] * deltas[output_idx];
+                    }
+                }
+            } else {
+                for (size_t output_idx = 0; output_idx < outputs_.size(); ++output_idx) {
+                    for (size_t input_idx = 0; input_idx < inputs_.size(); ++input_idx) {
+                        size_t weight_idx = input_idx + (output_idx * inputs_.size());
+                        weight_gradients_[weight_idx] = inputs_[input_idx] * deltas[output_idx];
+                    }
                 }
             }
             
@@ -144,6 +327,95 @@ namespace ANN {
             }
             
             // E. Compute input (weights * deltas) gradients to pass back to previous layer
+            return compute_input_gradients(deltas);
+        }
+
+        //
+        // Backward pass and plain SGD step in one, for per sample training.
+        // The input gradients are taken first, while the weights are still the ones used in the
+        // forward pass, then lr * input × delta is subtracted straight from the weights.
+        // weight_gradients_ and bias_gradients_ are neither written nor needed.
+        //
+        std::vector<double> backward_and_update(const std::vector<double>& loss_gradients, double lr)
+        {
+            std::vector<double> deltas = compute_deltas(loss_gradients);
+            std::vector<double> input_gradients = compute_input_gradients(deltas);
+
+            const size_t input_size = inputs_.size();
+            for (size_t output_idx = 0; output_idx < outputs_.size(); ++output_idx) {
+                const double step = lr * deltas[output_idx];
+                double* weight_row = &weights_[output_idx * input_size];
+                if (sparse_active_) {
+                    // Weights of zero inputs do not move
+                    for (size_t input_idx : active_inputs_) {
+                        weight_row[input_idx] -= step * inputs_[input_idx];
+                    }
+                } else {
+                    for (size_t input_idx = 0; input_idx < input_size; ++input_idx) {
+                        weight_row[input_idx] -= step * inputs_[input_idx];
+                    }
+                }
+                biases_[output_idx] -= step;
+            }
+
+            return input_gradients;
+        }
+
+        //
+        // δ = ∂Loss/∂z = ∂Loss/∂output × ∂output/∂z for every output neuron
+        //
+        std::vector<double> compute_deltas(const std::vector<double>& loss_gradients) const
+        {
+            // A. Compute activation function derivatives, from the outputs when the activation allows
+            // (sigmoid: y(1 - y), no second exp), otherwise from the stored pre-activation values
+            std::vector<double> activation_gradients(outputs_.size());
+            if (output_derivative) {
+                for (size_t i = 0; i < outputs_.size(); ++i) {
+                    activation_gradients[i] = output_derivative(outputs_[i]);
+                }
+            } else {
+                if (inference_mode_) {
+                    throw std::runtime_error("Layer in inference mode keeps no pre-activations for its activation derivative");
+                }
+                for (size_t i = 0; i < outputs_.size(); ++i) {
+                    activation_gradients[i] = activation_derivative(pre_activations_[i]);
+                }
+            }
+            
+            // B. Compute error terms (δ = ∂Loss/∂z = ∂Loss/∂output × ∂output/∂z)
+            std::vector<double> deltas(outputs_.size());
+            for (size_t i = 0; i < outputs_.size(); ++i) {
+                deltas[i] = loss_gradients[i] * activation_gradients[i];
+            }
+            return deltas;
+        }
+
+        //
+        // ∂Loss/∂input = weightsᵀ × δ, passed back to the previous layer.
+        // Walks the weights in storage order, one output row at a time scaled by its delta and
+        // added into the gradients, so every weight read is sequential. Each input gradient still
+        // sums over the outputs in the same order, the result matches the strided kernel exactly.
+        //
+        std::vector<double> compute_input_gradients(const std::vector<double>& deltas) const
+        {
+            const size_t input_size = inputs_.size();
+            std::vector<double> input_gradients(input_size, 0.0);
+            for (size_t output_idx = 0; output_idx < outputs_.size(); ++output_idx) {
+                const double delta = deltas[output_idx];
+                const double* weight_row = &weights_[output_idx * input_size];
+                for (size_t input_idx = 0; input_idx < input_size; ++input_idx) {
+                    input_gradients[input_idx] += weight_row[input_idx] * delta;
+                }
+            }
+            return input_gradients;
+        }
+
+        //
+        // The original input gradient kernel, one input at a time down a weight column, a stride of
+        // input_size doubles per multiply. Kept as the reference for tests and benchmarks.
+        //
+        std::vector<double> compute_input_gradients_strided(const std::vector<double>& deltas) const
+        {
             std::vector<double> input_gradients(inputs_.size(), 0.0);
             for (size_t input_idx = 0; input_idx < inputs_.size(); ++input_idx) {
                 for (size_t output_idx = 0; output_idx < outputs_.size(); ++output_idx) {
@@ -151,25 +423,110 @@ namespace ANN {
                     input_gradients[input_idx] += weights_[weight_idx] * deltas[output_idx];
                 }
             }
-            
             return input_gradients;
         }
 
+        //
+        // z = weights * input + bias for every output neuron
+        //
+        void compute_pre_activations(const double* input, double* pre_activations) const
+        {
+            const size_t input_size = inputs_.size();
+
+            for(size_t output_index = 0; output_index < outputs_.size(); output_index++) {
+                const double* weight_row = &weights_[output_index * input_size];
+
+                double sum = 0.0;
+                for(size_t input_index = 0; input_index < input_size; input_index++) 
+                {
+                    sum += input[input_index] * weight_row[input_index];
+                }
+                
+                pre_activations[output_index] = sum + biases_[output_index];
+            }
+        }
+
+        //
+        // Sparse input path, for mostly zero inputs such as normalised digit images.
+        // When the fraction of non-zero inputs is at or below threshold, forward, the weight gradients
+        // and the fused update only visit the non-zero inputs. 0 turns the check off.
+        // Skipping x = 0 terms drops only exact zeros from each sum, results match the dense path.
+        //
+        void set_sparse_input_threshold(double threshold) {
+            sparse_threshold_ = threshold;
+            sparse_active_ = false;
+        }
+
+        double sparse_input_threshold() const { return sparse_threshold_; }
+
+        // Whether the last forward() took the sparse path
+        bool sparse_inputs_active() const { return sparse_active_; }
+
+        //
+        // z = weights * input + bias over the listed non-zero inputs only
+        //
+        void compute_pre_activations_sparse(const double* input, const std::vector<size_t>& active, double* pre_activations) const
+        {
+            const size_t input_size = inputs_.size();
+
+            for (size_t output_index = 0; output_index < outputs_.size(); output_index++) {
+                const double* weight_row = &weights_[output_index * input_size];
+
+                double sum = 0.0;
+                for (size_t input_index : active) {
+                    sum += input[input_index] * weight_row[input_index];
+                }
+
+                pre_activations[output_index] = sum + biases_[output_index];
+            }
+        }
+
         std::vector<double> inputs_;    // input values, place to store result of previous layer or set inputs if first layer
-        std::vector<double> weights_;   // size = current neurons * previous neurons
-        std::vector<double> biases_;    // size = current neurons. one bias per output neuron
-        std::vector<double> pre_activations_;  // pre-activation values (z = weights*inputs + bias)
+        std::span<double> weights_;     // size = current neurons * previous neurons, view into arena_
+        std::span<double> biases_;      // size = current neurons. one bias per output neuron, view into arena_
+        std::vector<double> pre_activations_;  // pre-activation values (z = weights*inputs + bias), empty in inference mode
         std::vector<double> outputs_;   // activation value, result of activation function
         
-        // Gradient storage for backpropagation
-        std::vector<double> weight_gradients_;  // ∂Loss/∂weights, same size as weights_
-        std::vector<double> bias_gradients_;    // ∂Loss/∂biases, same size as biases_
+        // Gradient storage for backpropagation, views into the gradient block of arena_
+        // (empty when the arena has no gradient block, see Network::set_fused_update)
+        std::span<double> weight_gradients_;  // ∂Loss/∂weights, same size as weights_
+        std::span<double> bias_gradients_;    // ∂Loss/∂biases, same size as biases_
+
+        std::shared_ptr<ParameterArena> arena_;  // owns the memory behind the four views above
 
         std::shared_ptr<Layer> previous_layer;  // pointer to previous layer, null if first layer
         std::shared_ptr<Layer> next_layer;      // pointer to next layer, null if last layer
 
         std::function<double(double)> activation_function;      // activation function for this layer
         std::function<double(double)> activation_derivative;   // derivative of activation function
+        std::function<double(double)> output_derivative;       // the derivative from the output, empty if it needs z
+        bool inference_mode_ = false;                           // no pre-activations kept, see set_inference_mode
+
+        double sparse_threshold_ = 0.0;          // max non-zero input fraction for the sparse path, 0 = never
+        bool sparse_active_ = false;             // last forward() used the sparse path
+        std::vector<size_t> active_inputs_;      // indices of the non-zero inputs of the last forward()
+
+        Precision inference_precision_ = Precision::Double;  // weights infer_batch reads
+        std::vector<uint16_t> compact_weights_;  // float16/bfloat16 snapshot of weights_, empty for Double
+        std::vector<float> compact_biases_;
+
+    private:
+        // Collect the non-zero inputs and decide between the sparse and dense kernels
+        bool use_sparse_inputs() {
+            sparse_active_ = false;
+            if (sparse_threshold_ <= 0.0) {
+                return false;
+            }
+
+            active_inputs_.clear();
+            for (size_t i = 0; i < inputs_.size(); ++i) {
+                if (inputs_[i] != 0.0) {
+                    active_inputs_.push_back(i);
+                }
+            }
+            sparse_active_ = active_inputs_.size() <= sparse_threshold_ * inputs_.size();
+            return sparse_active_;
+        }
     };
 
 } // namespace layers
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "parameter_arena.hpp"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace ANN {
+
+ParameterArena::ParameterArena(std::size_t capacity, bool huge_pages, bool gradients)
+    : capacity_(aligned_size(capacity))
+    , huge_pages_(huge_pages)
+    , parameters_(allocate_block())
+    , gradients_(gradients ? allocate_block() : Block())
+{
+}
+
+void ParameterArena::AlignedFree::operator()(double* block) const {
+    ::operator delete(block, std::align_val_t{alignment});
+}
+
+ParameterArena::Block ParameterArena::allocate_block() const {
+    const std::size_t alignment = huge_pages_ ? HUGE_PAGE_SIZE : ALIGNMENT;
+
+    // Whole multiples of the alignment, so madvise covers complete huge pages
+    std::size_t bytes = std::max<std::size_t>(capacity_, 1) * sizeof(double);
+    bytes = (bytes + alignment - 1) / alignment * alignment;
+
+    // Throws std::bad_alloc on failure
+    auto* block = static_cast<double*>(::operator new(bytes, std::align_val_t{alignment}));
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (huge_pages_) {
+        // Advisory only, without transparent huge page support we silently keep normal pages
+        madvise(block, bytes, MADV_HUGEPAGE);
+    }
+#endif
+
+    std::fill(block, block + bytes / sizeof(double), 0.0);
+    return Block(block, AlignedFree{alignment});
+}
+
+std::size_t ParameterArena::reserve(std::size_t count) {
+    const std::size_t size = aligned_size(count);
+    if (used_ + size > capacity_) {
+        throw std::length_error("ParameterArena is full: " + std::to_string(used_ + size) + " of " + std::to_string(capacity_));
+    }
+
+    const std::size_t offset = used_;
+    used_ += size;
+    return offset;
+}
+
+void ParameterArena::zero_gradients() {
+    if (gradients_) {
+        std::fill(gradients_.get(), gradients_.get() + used_, 0.0);
+    }
+}
+
+} // namespace ANN
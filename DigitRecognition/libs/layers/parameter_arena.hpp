@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+namespace ANN {
+
+    //
+    // One block holding every parameter of a network and a second, identically laid out block
+    // for their gradients. Layers take views into both, so an optimiser step, zeroing or copying
+    // the gradients is a single pass over contiguous memory.
+    // Each reservation starts on a 64 byte (cache line) boundary. With huge_pages the blocks
+    // are 2MB aligned and the kernel is asked to back them with transparent huge pages (Linux only).
+    //
+    class ParameterArena {
+    public:
+        static constexpr std::size_t ALIGNMENT = 64;
+        static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+        // Capacity in doubles, both blocks start zeroed.
+        // Without gradients only the parameter block exists and the gradient views are empty.
+        explicit ParameterArena(std::size_t capacity, bool huge_pages = false, bool gradients = true);
+
+        // Number of doubles needed to reserve count values, padding the start to the next cache line
+        static std::size_t aligned_size(std::size_t count) {
+            constexpr std::size_t per_line = ALIGNMENT / sizeof(double);
+            return (count + per_line - 1) / per_line * per_line;
+        }
+
+        // Hand out the next count values of both blocks, returns their offset
+        std::size_t reserve(std::size_t count);
+
+        std::span<double> parameters(std::size_t offset, std::size_t count) { return {parameters_.get() + offset, count}; }
+        std::span<double> gradients(std::size_t offset, std::size_t count) {
+            return gradients_ ? std::span<double>{gradients_.get() + offset, count} : std::span<double>{};
+        }
+
+        // Everything reserved so far, padding included (padding stays zero)
+        std::span<double> parameters() { return {parameters_.get(), used_}; }
+        std::span<double> gradients() { return gradients_ ? std::span<double>{gradients_.get(), used_} : std::span<double>{}; }
+        std::span<const double> parameters() const { return {parameters_.get(), used_}; }
+        std::span<const double> gradients() const {
+            return gradients_ ? std::span<const double>{gradients_.get(), used_} : std::span<const double>{};
+        }
+
+        void zero_gradients();
+
+        std::size_t capacity() const { return capacity_; }
+        bool huge_pages() const { return huge_pages_; }
+        bool has_gradients() const { return static_cast<bool>(gradients_); }
+
+    private:
+        // Blocks come from aligned operator new, which MSVC has and std::aligned_alloc it does not
+        struct AlignedFree {
+            std::size_t alignment;  // as allocated
+            void operator()(double* block) const;
+        };
+        using Block = std::unique_ptr<double[], AlignedFree>;
+
+        Block allocate_block() const;
+
+        std::size_t capacity_;
+        std::size_t used_ = 0;
+        bool huge_pages_;
+        Block parameters_;
+        Block gradients_;
+    };
+
+} // namespace ANN
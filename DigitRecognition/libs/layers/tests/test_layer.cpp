@@ -4,6 +4,7 @@
 #include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <span>
 
 namespace Tests {
 
@@ -13,7 +14,7 @@ bool are_close(double a, double b, double tolerance = 1e-6) {
 }
 
 // Helper function to print vectors for debugging
-void print_vector(const std::vector<double>& vec, const std::string& name) {
+void print_vector(std::span<const double> vec, const std::string& name) {
     std::cout << name << ": ";
     for (double val : vec) {
         std::cout << std::fixed << std::setprecision(4) << val << " ";
@@ -1,15 +1,368 @@
 #include "../layers.h"
+#include "../parameter_arena.hpp"
+#include "../half_precision.hpp"
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <utility>
 #include <vector>
 
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
 
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+static bool is_cache_line_aligned(const double* pointer) {
+    return reinterpret_cast<std::uintptr_t>(pointer) % ANN::ParameterArena::ALIGNMENT == 0;
+}
+
+bool test_arena_layout() {
+    std::cout << "Testing parameter arena alignment and layout..." << std::endl;
+
+    ANN::ParameterArena arena(ANN::ParameterArena::aligned_size(13) + ANN::ParameterArena::aligned_size(3));
+    size_t first = arena.reserve(13);
+    size_t second = arena.reserve(3);
+
+    ASSERT_TRUE(first == 0);
+    ASSERT_TRUE(second == ANN::ParameterArena::aligned_size(13));
+    ASSERT_TRUE(is_cache_line_aligned(arena.parameters(second, 3).data()));
+    ASSERT_TRUE(is_cache_line_aligned(arena.gradients(second, 3).data()));
+    ASSERT_TRUE(arena.parameters().size() == arena.capacity());
+
+    bool threw = false;
+    try {
+        arena.reserve(1);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    std::fill(arena.gradients().begin(), arena.gradients().end(), 1.0);
+    arena.zero_gradients();
+    ASSERT_TRUE(std::ranges::all_of(arena.gradients(), [](double g) { return g == 0.0; }));
+
+    std::cout << "✓ Arena layout tests passed" << std::endl;
+    return true;
+}
+
+bool test_shared_arena_binding() {
+    std::cout << "Testing layers rebound into a shared arena..." << std::endl;
+
+    ANN::Layer first(5, 4);
+    ANN::Layer second(4, 3);
+    std::vector<double> first_weights(first.weights_.begin(), first.weights_.end());
+    std::vector<double> second_weights(second.weights_.begin(), second.weights_.end());
+
+    auto arena = std::make_shared<ANN::ParameterArena>(first.parameter_capacity() + second.parameter_capacity());
+    first.bind_parameters(arena);
+    second.bind_parameters(arena);
+
+    // Values survive the move and the views now sit inside the one block
+    ASSERT_TRUE(std::ranges::equal(first.weights_, first_weights));
+    ASSERT_TRUE(std::ranges::equal(second.weights_, second_weights));
+    ASSERT_TRUE(first.weights_.data() == arena->parameters().data());
+    ASSERT_TRUE(second.biases_.data() + second.biases_.size() <= arena->parameters().data() + arena->parameters().size());
+    ASSERT_TRUE(is_cache_line_aligned(second.weights_.data()));
+    ASSERT_TRUE(is_cache_line_aligned(first.bias_gradients_.data()));
+
+    // Writing through the arena is seen by the layer
+    arena->parameters()[0] = 42.0;
+    ASSERT_TRUE(first.weights_[0] == 42.0);
+
+    std::cout << "✓ Shared arena tests passed" << std::endl;
+    return true;
+}
+
+bool test_layer_copy_is_deep() {
+    std::cout << "Testing layer copies own their parameters..." << std::endl;
+
+    ANN::Layer original(6, 2);
+    ANN::Layer copy(original);
+    ASSERT_TRUE(copy.weights_.data() != original.weights_.data());
+    ASSERT_TRUE(std::ranges::equal(copy.weights_, original.weights_));
+
+    copy.weights_[0] = original.weights_[0] + 1.0;
+    ASSERT_TRUE(copy.weights_[0] != original.weights_[0]);
+
+    ANN::Layer assigned(1, 1);
+    assigned = original;
+    ASSERT_TRUE(assigned.weights_.size() == original.weights_.size());
+    ASSERT_TRUE(assigned.weights_.data() != original.weights_.data());
+    ASSERT_TRUE(std::ranges::equal(assigned.biases_, original.biases_));
+
+    std::cout << "✓ Layer copy tests passed" << std::endl;
+    return true;
+}
+
+bool test_fused_backward_update() {
+    std::cout << "Testing fused backward and update against backward then update..." << std::endl;
+
+    ANN::WeightInitConfig config;
+    config.seed = 7;
+    ANN::Layer separate(5, 3, config, "relu");
+    ANN::Layer fused(5, 3, config, "relu");
+
+    const std::vector<double> inputs = {0.2, -0.4, 0.9, 0.1, 0.5};
+    const std::vector<double> loss_gradients = {0.3, -0.7, 0.25};
+    const double lr = 0.05;
+
+    separate.inputs_ = inputs;
+    fused.inputs_ = inputs;
+    separate.forward();
+    fused.forward();
+
+    auto separate_input_gradients = separate.backward(loss_gradients);
+    for (size_t i = 0; i < separate.weights_.size(); ++i) {
+        separate.weights_[i] -= lr * separate.weight_gradients_[i];
+    }
+    for (size_t i = 0; i < separate.biases_.size(); ++i) {
+        separate.biases_[i] -= lr * separate.bias_gradients_[i];
+    }
+
+    auto fused_input_gradients = fused.backward_and_update(loss_gradients, lr);
+
+    // Input gradients must come from the weights before the update
+    ASSERT_TRUE(fused_input_gradients.size() == separate_input_gradients.size());
+    for (size_t i = 0; i < fused_input_gradients.size(); ++i) {
+        ASSERT_NEAR(fused_input_gradients[i], separate_input_gradients[i], 1e-15);
+    }
+    for (size_t i = 0; i < fused.weights_.size(); ++i) {
+        ASSERT_NEAR(fused.weights_[i], separate.weights_[i], 1e-15);
+    }
+    for (size_t i = 0; i < fused.biases_.size(); ++i) {
+        ASSERT_NEAR(fused.biases_[i], separate.biases_[i], 1e-15);
+    }
+
+    std::cout << "✓ Fused update tests passed" << std::endl;
+    return true;
+}
+
+bool test_input_gradient_kernels_match() {
+    std::cout << "Testing row order input gradients against the strided kernel..." << std::endl;
+
+    ANN::WeightInitConfig config;
+    config.seed = 11;
+    for (auto [inputs, outputs] : {std::pair{784, 128}, std::pair{33, 7}, std::pair{10, 1}}) {
+        ANN::Layer layer(inputs, outputs, config);
+        std::vector<double> deltas(outputs);
+        for (int o = 0; o < outputs; ++o) {
+            deltas[o] = 0.01 * (o - outputs / 2);
+        }
+
+        // Same additions in the same order per element, so equal bit for bit
+        ASSERT_TRUE(layer.compute_input_gradients(deltas) == layer.compute_input_gradients_strided(deltas));
+    }
+
+    std::cout << "✓ Input gradient kernel tests passed" << std::endl;
+    return true;
+}
+
+bool test_sparse_input_path() {
+    std::cout << "Testing sparse input path against the dense one..." << std::endl;
+
+    ANN::WeightInitConfig config;
+    config.seed = 5;
+    ANN::Layer dense(20, 6, config, "relu");
+    ANN::Layer sparse(20, 6, config, "relu");
+    sparse.set_sparse_input_threshold(0.3);
+
+    std::vector<double> inputs(20, 0.0);
+    inputs[2] = 0.8;
+    inputs[7] = 0.1;
+    inputs[15] = 0.5;   // 15% non-zero
+    dense.inputs_ = inputs;
+    sparse.inputs_ = inputs;
+
+    ASSERT_TRUE(sparse.forward() == dense.forward());
+    ASSERT_TRUE(sparse.sparse_inputs_active());
+    ASSERT_TRUE(!dense.sparse_inputs_active());
+
+    const std::vector<double> loss_gradients = {0.2, -0.1, 0.4, 0.3, -0.5, 0.05};
+    ASSERT_TRUE(sparse.backward(loss_gradients) == dense.backward(loss_gradients));
+    ASSERT_TRUE(std::ranges::equal(sparse.weight_gradients_, dense.weight_gradients_));
+
+    sparse.backward_and_update(loss_gradients, 0.1);
+    dense.backward_and_update(loss_gradients, 0.1);
+    ASSERT_TRUE(std::ranges::equal(sparse.weights_, dense.weights_));
+    ASSERT_TRUE(std::ranges::equal(sparse.biases_, dense.biases_));
+
+    // Above the threshold the dense kernel is used
+    std::fill(inputs.begin(), inputs.begin() + 10, 0.25);
+    sparse.inputs_ = inputs;
+    sparse.forward();
+    ASSERT_TRUE(!sparse.sparse_inputs_active());
+
+    std::cout << "✓ Sparse input tests passed" << std::endl;
+    return true;
+}
+
+bool test_half_conversions() {
+    std::cout << "Testing float16 and bfloat16 conversions..." << std::endl;
+
+    using namespace ANN::Half;
+    ASSERT_TRUE(float_to_fp16(1.0f) == 0x3c00);
+    ASSERT_TRUE(float_to_fp16(-2.0f) == 0xc000);
+    ASSERT_TRUE(float_to_fp16(65504.0f) == 0x7bff);
+    ASSERT_TRUE(float_to_fp16(65520.0f) == 0x7c00);             // rounds up to infinity
+    ASSERT_TRUE(float_to_fp16(5.9604645e-8f) == 0x0001);        // smallest denormal
+    ASSERT_TRUE(float_to_fp16(1.0f + 1.0f / 2048.0f) == 0x3c00);  // tie rounds to even
+    ASSERT_TRUE(fp16_to_float(0x3555) == 0.333251953125f);
+    ASSERT_TRUE(fp16_to_float(0x0001) == 5.9604645e-8f);
+
+    ASSERT_TRUE(float_to_bf16(1.0f) == 0x3f80);
+    ASSERT_TRUE(float_to_bf16(1.0f + 1.0f / 256.0f) == 0x3f80);   // tie rounds to even
+    ASSERT_TRUE(float_to_bf16(1.0f + 3.0f / 256.0f) == 0x3f82);
+    ASSERT_TRUE(bf16_to_float(0xc040) == -3.0f);
+
+    // Bulk conversions (hardware when available) agree with the scalar ones
+    std::vector<double> values;
+    for (int i = -500; i < 500; ++i) {
+        values.push_back(i * 0.0137 + (i % 3) * 1e-4);
+    }
+    for (auto precision : {ANN::Precision::Float16, ANN::Precision::BFloat16}) {
+        std::vector<uint16_t> encoded(values.size());
+        std::vector<float> decoded(values.size());
+        encode(values.data(), encoded.data(), values.size(), precision);
+        decode(encoded.data(), decoded.data(), values.size(), precision);
+        for (size_t i = 0; i < values.size(); ++i) {
+            const float value = static_cast<float>(values[i]);
+            const bool half = precision == ANN::Precision::Float16;
+            ASSERT_TRUE(encoded[i] == (half ? float_to_fp16(value) : float_to_bf16(value)));
+            ASSERT_TRUE(decoded[i] == (half ? fp16_to_float(encoded[i]) : bf16_to_float(encoded[i])));
+        }
+    }
+
+    std::cout << "✓ Conversion tests passed (F16C " << (hardware_fp16() ? "yes" : "no")
+              << ", AVX-512 BF16 " << (hardware_bf16() ? "yes" : "no") << ")" << std::endl;
+    return true;
+}
+
+bool test_compact_inference() {
+    std::cout << "Testing float16/bfloat16 inference against double..." << std::endl;
+
+    ANN::WeightInitConfig config;
+    config.method = "xavier";
+    config.seed = 13;
+    ANN::Layer layer(200, 16, config, "sigmoid");
+
+    const size_t batch = 3;
+    std::vector<double> inputs(batch * 200);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        inputs[i] = (i % 17) / 16.0;
+    }
+    std::vector<double> expected(batch * 16), actual(batch * 16);
+    std::vector<float> scratch;
+    layer.infer_batch(inputs.data(), batch, expected.data(), scratch);
+
+    // Relative step of bfloat16 is 2^-8, of float16 2^-11
+    for (auto [precision, tolerance] : {std::pair{ANN::Precision::Float16, 2e-3}, std::pair{ANN::Precision::BFloat16, 1.5e-2}}) {
+        layer.set_inference_precision(precision);
+        ASSERT_TRUE(layer.compact_weights_.size() == layer.weights_.size());
+        layer.infer_batch(inputs.data(), batch, actual.data(), scratch);
+        for (size_t i = 0; i < actual.size(); ++i) {
+            ASSERT_NEAR(actual[i], expected[i], tolerance);
+        }
+
+        // Copies keep the compact weights
+        ANN::Layer copy(layer);
+        ASSERT_TRUE(copy.inference_precision() == precision);
+        ASSERT_TRUE(copy.compact_weights_ == layer.compact_weights_);
+    }
+
+    layer.set_inference_precision(ANN::Precision::Double);
+    ASSERT_TRUE(layer.compact_weights_.empty());
+    layer.infer_batch(inputs.data(), batch, actual.data(), scratch);
+    ASSERT_TRUE(actual == expected);
+
+    std::cout << "✓ Compact inference tests passed" << std::endl;
+    return true;
+}
+
+bool test_derivatives_from_outputs() {
+    std::cout << "Testing activation derivatives from cached outputs..." << std::endl;
+
+    ANN::WeightInitConfig config;
+    config.method = "xavier";
+    config.seed = 21;
+    std::vector<double> inputs(30), loss_gradients(8);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        inputs[i] = (static_cast<double>(i % 7) - 3.0) / 3.0;
+    }
+    for (size_t o = 0; o < loss_gradients.size(); ++o) {
+        loss_gradients[o] = 0.1 * (static_cast<double>(o) - 3.5);
+    }
+
+    for (const std::string activation : {"sigmoid", "relu"}) {
+        ANN::Layer layer(30, 8, config, activation);
+        layer.inputs_ = inputs;
+        layer.forward();
+
+        // Same deltas as the derivative of the stored pre-activations, to the bit
+        auto derivative = ANN::get_activation_derivative(activation);
+        auto deltas = layer.compute_deltas(loss_gradients);
+        for (size_t o = 0; o < deltas.size(); ++o) {
+            ASSERT_TRUE(deltas[o] == loss_gradients[o] * derivative(layer.pre_activations_[o]));
+        }
+
+        // Inference mode keeps no pre-activations but gives the same outputs and deltas
+        ANN::Layer inference(layer);
+        inference.set_inference_mode(true);
+        ASSERT_TRUE(inference.pre_activations_.empty());
+        inference.forward();
+        ASSERT_TRUE(inference.outputs_ == layer.outputs_);
+        ASSERT_TRUE(inference.compute_deltas(loss_gradients) == deltas);
+
+        // Without an output derivative the pre-activations are needed
+        inference.set_activation(ANN::get_activation(activation), derivative);
+        bool threw = false;
+        try {
+            inference.compute_deltas(loss_gradients);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+        inference.set_inference_mode(false);
+        inference.forward();
+        ASSERT_TRUE(inference.compute_deltas(loss_gradients) == deltas);
+    }
+
+    std::cout << "✓ Output derivative tests passed" << std::endl;
+    return true;
+}
 
 int main() {
     std::cout << "=== Layers Library Test ===" << std::endl;
-    // Placeholder for actual layer tests
-    std::cout << "Layers tests are not yet implemented." << std::endl;
-    std::cout << "🎉 All tests passed!" << std::endl;
-    return 0;
-}
\ No newline at end of file
+    bool all_passed = true;
+    all_passed &= test_arena_layout();
+    all_passed &= test_shared_arena_binding();
+    all_passed &= test_layer_copy_is_deep();
+    all_passed &= test_fused_backward_update();
+    all_passed &= test_input_gradient_kernels_match();
+    all_passed &= test_sparse_input_path();
+    all_passed &= test_half_conversions();
+    all_passed &= test_compact_inference();
+    all_passed &= test_derivatives_from_outputs();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,116 @@
+#include "../layers.h"
+#include "../../random/philox.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+bool test_philox_known_answers() {
+    std::cout << "Testing Philox4x32-10 against the Random123 known answers..." << std::endl;
+
+    using ANN::Random::Philox4x32;
+    ASSERT_TRUE((Philox4x32::generate({0, 0, 0, 0}, {0, 0})
+                 == Philox4x32::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    ASSERT_TRUE((Philox4x32::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff})
+                 == Philox4x32::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    ASSERT_TRUE((Philox4x32::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0})
+                 == Philox4x32::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+
+    std::cout << "✓ Known answer tests passed" << std::endl;
+    return true;
+}
+
+bool test_thread_count_independence() {
+    std::cout << "Testing fills are identical for any thread count..." << std::endl;
+
+    const ANN::Random::CounterRng rng(1234, 7);
+    const size_t count = 200000;   // large enough to be split over threads
+
+    std::vector<double> single(count), several(count), many(count);
+    auto generator = [&rng](size_t i) { return rng.normal(i); };
+    ANN::Random::parallel_fill(single.data(), count, generator, 1);
+    ANN::Random::parallel_fill(several.data(), count, generator, 3);
+    ANN::Random::parallel_fill(many.data(), count, generator, 8);
+
+    ASSERT_TRUE(single == several);
+    ASSERT_TRUE(single == many);
+
+    // Standard normal moments
+    double sum = 0.0, sum_squares = 0.0;
+    for (double value : single) {
+        sum += value;
+        sum_squares += value * value;
+    }
+    ASSERT_NEAR(sum / count, 0.0, 0.01);
+    ASSERT_NEAR(sum_squares / count, 1.0, 0.01);
+
+    std::cout << "✓ Thread count independence tests passed" << std::endl;
+    return true;
+}
+
+bool test_seeded_layers() {
+    std::cout << "Testing seeded layer initialisation..." << std::endl;
+
+    ANN::WeightInitConfig config;
+    config.method = "uniform";
+    config.range = {-0.5, 0.5};
+    config.seed = 42;
+
+    config.threads = 1;
+    ANN::Layer serial(300, 200, config);
+    config.threads = 4;
+    ANN::Layer parallel(300, 200, config);
+    ASSERT_TRUE(std::ranges::equal(serial.weights_, parallel.weights_));
+
+    for (double weight : serial.weights_) {
+        ASSERT_TRUE(weight >= -0.5 && weight < 0.5);
+    }
+
+    // Another stream or seed gives different weights
+    config.stream = 1;
+    ANN::Layer other_stream(300, 200, config);
+    ASSERT_TRUE(!std::ranges::equal(other_stream.weights_, serial.weights_));
+
+    config.stream = 0;
+    config.seed = 43;
+    ANN::Layer other_seed(300, 200, config);
+    ASSERT_TRUE(!std::ranges::equal(other_seed.weights_, serial.weights_));
+
+    std::cout << "✓ Seeded layer tests passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Parallel Weight Initialisation Tests" << std::endl;
+    std::cout << "============================================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_philox_known_answers();
+    all_passed &= test_thread_count_independence();
+    all_passed &= test_seeded_layers();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
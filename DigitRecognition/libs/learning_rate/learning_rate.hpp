@@ -1,33 +1,30 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
 #include <string>
 #include <nlohmann/json.hpp>
 
 namespace ANN {
     struct LearningRateConfig {
         double initial = 0.01;
-        std::string schedule = "constant"; // "constant", "exponential", "linear"
-        double decay = 0.0; // Used for exponential/linear
+        std::string schedule = "constant"; // "constant", "exponential", "linear", "step", "cosine", "one_cycle"
+        double decay = 0.0; // Used for exponential/linear, per epoch
         double min = 0.0001; // Minimum learning rate
-        int step = 1; // Step interval for schedule update
-        int epoch = 0; // Current epoch
+        int step = 1; // Epochs between drops for the step schedule
+        double gamma = 0.1; // Factor applied every step epochs for the step schedule
+        double warmup_epochs = 0.0; // Ramp up linearly from zero over this many epochs, any schedule
+        double cycle_peak = 0.3; // one_cycle: fraction of the run spent rising from min to initial
+        std::string update = "epoch"; // "epoch" changes the rate once per epoch, "iteration" once per sample
 
         LearningRateConfig() = default;
         LearningRateConfig(double initial_, const std::string& schedule_, double decay_, double min_, int step_)
-            : initial(initial_), schedule(schedule_), decay(decay_), min(min_), step(step_), epoch(0) {}
+            : initial(initial_), schedule(schedule_), decay(decay_), min(min_), step(step_) {}
 
-        double get() const {
-            return initial;
-        }
-
-        void update(int current_epoch) {
-            epoch = current_epoch;
-            if (schedule == "constant") {
-                // No change
-            } else if (schedule == "exponential") {
-                initial = std::max(min, initial * std::exp(-decay * epoch));
-            } else if (schedule == "linear") {
-                initial = std::max(min, initial - decay * epoch);
-            }
+        static bool is_known_schedule(const std::string& name) {
+            return name == "constant" || name == "exponential" || name == "linear"
+                || name == "step" || name == "cosine" || name == "one_cycle";
         }
 
         static LearningRateConfig from_json(const nlohmann::json& j) {
@@ -37,7 +34,103 @@ namespace ANN {
             if (j.contains("decay")) cfg.decay = j["decay"].get<double>();
             if (j.contains("min")) cfg.min = j["min"].get<double>();
             if (j.contains("step")) cfg.step = j["step"].get<int>();
+            if (j.contains("gamma")) cfg.gamma = j["gamma"].get<double>();
+            if (j.contains("warmup_epochs")) cfg.warmup_epochs = j["warmup_epochs"].get<double>();
+            if (j.contains("cycle_peak")) cfg.cycle_peak = j["cycle_peak"].get<double>();
+            if (j.contains("update")) cfg.update = j["update"].get<std::string>();
             return cfg;
         }
+
+        nlohmann::json to_json() const {
+            return {
+                {"initial", initial},
+                {"schedule", schedule},
+                {"decay", decay},
+                {"min", min},
+                {"step", step},
+                {"gamma", gamma},
+                {"warmup_epochs", warmup_epochs},
+                {"cycle_peak", cycle_peak},
+                {"update", update}
+            };
+        }
+    };
+
+    //
+    // Learning rate as a function of training progress. The rate only depends on where training
+    // is (epoch, and sample within the epoch when update is "iteration"), never on how often it
+    // was asked, so it can be queried per sample without compounding.
+    //
+    class LearningRateScheduler {
+    public:
+        LearningRateScheduler(const LearningRateConfig& config, int total_epochs, size_t iterations_per_epoch = 0)
+            : config_(config)
+            , total_epochs_(std::max(1, total_epochs))
+            , iterations_per_epoch_(iterations_per_epoch) {}
+
+        // Whether the rate can change within an epoch
+        bool per_iteration() const {
+            return config_.update == "iteration" && iterations_per_epoch_ > 0;
+        }
+
+        // Rate for sample iteration of epoch (both 0 based)
+        double rate(int epoch, size_t iteration = 0) const {
+            double progress = epoch;  // in epochs
+            if (per_iteration()) {
+                progress += static_cast<double>(iteration) / iterations_per_epoch_;
+            }
+
+            double lr = scheduled(epoch, progress);
+            if (progress < config_.warmup_epochs) {
+                // Ramp reaches the scheduled rate at the end of warmup, never zero at the first step
+                double warmup_steps = per_iteration() ? config_.warmup_epochs * iterations_per_epoch_ : config_.warmup_epochs;
+                double step = per_iteration() ? progress * iterations_per_epoch_ : progress;
+                lr *= (step + 1.0) / (std::ceil(warmup_steps) + 1.0);
+            }
+            return lr;
+        }
+
+        const LearningRateConfig& config() const { return config_; }
+
+    private:
+        double scheduled(int epoch, double progress) const {
+            const double initial = config_.initial;
+            const double min = std::min(config_.min, initial);
+
+            if (config_.schedule == "exponential") {
+                return std::max(min, initial * std::exp(-config_.decay * progress));
+            }
+            if (config_.schedule == "linear") {
+                return std::max(min, initial - config_.decay * progress);
+            }
+            if (config_.schedule == "step") {
+                // Drops are epoch boundaries even when updating per iteration
+                int drops = epoch / std::max(1, config_.step);
+                return std::max(min, initial * std::pow(config_.gamma, drops));
+            }
+            if (config_.schedule == "cosine") {
+                return cosine(initial, min, progress / total_epochs_);
+            }
+            if (config_.schedule == "one_cycle") {
+                // Linear rise from min to initial, then cosine annealing back down to min
+                const double fraction = progress / total_epochs_;
+                const double peak = std::clamp(config_.cycle_peak, 0.0, 1.0);
+                if (fraction < peak) {
+                    return min + (initial - min) * fraction / peak;
+                }
+                return cosine(initial, min, peak < 1.0 ? (fraction - peak) / (1.0 - peak) : 1.0);
+            }
+            return initial;  // constant
+        }
+
+        // Half cosine from high at fraction 0 down to low at fraction 1
+        static double cosine(double high, double low, double fraction) {
+            fraction = std::clamp(fraction, 0.0, 1.0);
+            return low + 0.5 * (high - low) * (1.0 + std::cos(std::numbers::pi * fraction));
+        }
+
+        LearningRateConfig config_;
+        int total_epochs_;
+        size_t iterations_per_epoch_;
     };
 }
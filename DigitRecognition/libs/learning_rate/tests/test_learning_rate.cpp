@@ -0,0 +1,172 @@
+#include "../learning_rate.hpp"
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+ANN::LearningRateConfig make_config(const std::string& schedule, double initial = 0.1, double min = 0.001) {
+    ANN::LearningRateConfig config;
+    config.schedule = schedule;
+    config.initial = initial;
+    config.min = min;
+    return config;
+}
+
+bool test_rate_does_not_compound() {
+    std::cout << "Testing the rate does not depend on how often it is asked..." << std::endl;
+
+    // The old per sample decay collapsed to min within an epoch, the rate is now a function of progress only
+    auto config = make_config("exponential");
+    config.decay = 0.05;
+    config.update = "iteration";
+    ANN::LearningRateScheduler scheduler(config, 10, 1000);
+
+    double first = scheduler.rate(3, 250);
+    for (size_t i = 0; i < 100000; ++i) {
+        scheduler.rate(3, i % 1000);
+    }
+    ASSERT_TRUE(scheduler.rate(3, 250) == first);
+    ASSERT_TRUE(scheduler.rate(9, 999) > config.min);
+
+    std::cout << "✓ Non compounding tests passed" << std::endl;
+    return true;
+}
+
+bool test_exponential() {
+    std::cout << "Testing exponential decay..." << std::endl;
+
+    auto config = make_config("exponential");
+    config.decay = 0.2;
+    ANN::LearningRateScheduler scheduler(config, 10);
+
+    for (int epoch = 0; epoch < 10; ++epoch) {
+        ASSERT_NEAR(scheduler.rate(epoch), 0.1 * std::exp(-0.2 * epoch), 1e-12);
+    }
+
+    // Per epoch updates ignore the sample within the epoch
+    ASSERT_TRUE(scheduler.rate(4, 123) == scheduler.rate(4));
+
+    std::cout << "✓ Exponential tests passed" << std::endl;
+    return true;
+}
+
+bool test_step() {
+    std::cout << "Testing step drops..." << std::endl;
+
+    auto config = make_config("step", 0.1, 1e-9);
+    config.step = 3;
+    config.gamma = 0.5;
+    ANN::LearningRateScheduler scheduler(config, 12);
+
+    for (int epoch = 0; epoch < 12; ++epoch) {
+        ASSERT_NEAR(scheduler.rate(epoch), 0.1 * std::pow(0.5, epoch / 3), 1e-12);
+    }
+
+    // Floored at min
+    config.min = 0.02;
+    ANN::LearningRateScheduler floored(config, 12);
+    ASSERT_NEAR(floored.rate(11), 0.02, 1e-12);
+
+    std::cout << "✓ Step tests passed" << std::endl;
+    return true;
+}
+
+bool test_cosine() {
+    std::cout << "Testing cosine annealing..." << std::endl;
+
+    ANN::LearningRateScheduler scheduler(make_config("cosine"), 10);
+
+    ASSERT_NEAR(scheduler.rate(0), 0.1, 1e-12);
+    ASSERT_NEAR(scheduler.rate(5), 0.5 * (0.1 + 0.001), 1e-12);
+    ASSERT_NEAR(scheduler.rate(10), 0.001, 1e-12);
+    for (int epoch = 1; epoch <= 10; ++epoch) {
+        ASSERT_TRUE(scheduler.rate(epoch) < scheduler.rate(epoch - 1));
+    }
+
+    std::cout << "✓ Cosine tests passed" << std::endl;
+    return true;
+}
+
+bool test_one_cycle() {
+    std::cout << "Testing one cycle..." << std::endl;
+
+    auto config = make_config("one_cycle");
+    config.cycle_peak = 0.3;
+    ANN::LearningRateScheduler scheduler(config, 10);
+
+    ASSERT_NEAR(scheduler.rate(0), 0.001, 1e-12);
+    ASSERT_NEAR(scheduler.rate(3), 0.1, 1e-12);
+    ASSERT_NEAR(scheduler.rate(10), 0.001, 1e-12);
+    for (int epoch = 1; epoch <= 3; ++epoch) {
+        ASSERT_TRUE(scheduler.rate(epoch) > scheduler.rate(epoch - 1));
+    }
+    for (int epoch = 4; epoch <= 10; ++epoch) {
+        ASSERT_TRUE(scheduler.rate(epoch) < scheduler.rate(epoch - 1));
+    }
+
+    std::cout << "✓ One cycle tests passed" << std::endl;
+    return true;
+}
+
+bool test_warmup() {
+    std::cout << "Testing warmup..." << std::endl;
+
+    for (const char* update : {"epoch", "iteration"}) {
+        auto config = make_config("constant");
+        config.warmup_epochs = 2.0;
+        config.update = update;
+        ANN::LearningRateScheduler scheduler(config, 10, 100);
+
+        // Never zero at the first step, rising to the scheduled rate when warmup ends
+        ASSERT_TRUE(scheduler.rate(0, 0) > 0.0);
+        double previous = 0.0;
+        for (int epoch = 0; epoch < 2; ++epoch) {
+            for (size_t i = 0; i < 100; i += 10) {
+                double rate = scheduler.rate(epoch, i);
+                ASSERT_TRUE(rate >= previous && rate < 0.1);
+                previous = rate;
+            }
+        }
+        ASSERT_NEAR(scheduler.rate(2, 0), 0.1, 1e-12);
+    }
+
+    std::cout << "✓ Warmup tests passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Learning Rate Tests" << std::endl;
+    std::cout << "===========================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_rate_does_not_compound();
+    all_passed &= test_exponential();
+    all_passed &= test_step();
+    all_passed &= test_cosine();
+    all_passed &= test_one_cycle();
+    all_passed &= test_warmup();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -1,13 +1,23 @@
 #pragma once
 
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 #include "../layers/layers.h"
 #include "../learning_rate/learning_rate.hpp"
+#include "../profiling/profiler.hpp"
+#include "../profiling/perf_counters.hpp"
 
 namespace ANN {
 
     // Convert integer label to one-hot vector
-    std::vector<double> label_to_one_hot_vector(int label, int num_classes = 10) {
+    inline std::vector<double> label_to_one_hot_vector(int label, int num_classes = 10) {
         std::vector<double> one_hot(num_classes, 0.0);
         if (label >= 0 && label < num_classes) {
             one_hot[label] = 1.0;
@@ -15,6 +25,44 @@ namespace ANN {
         return one_hot;
     }
 
+    // Index of the largest value, the predicted label for a vector of outputs
+    inline int argmax(const double* values, size_t count) {
+        int best = 0;
+        for (size_t i = 1; i < count; ++i) {
+            if (values[i] > values[best]) {
+                best = static_cast<int>(i);
+            }
+        }
+        return best;
+    }
+
+    //
+    // Scratch buffers for Network::infer_batch, one per inference thread
+    //
+    struct InferenceWorkspace {
+        std::vector<double> current;
+        std::vector<double> next;
+        std::vector<float> compact;     // float inputs and weight row, float16/bfloat16 weights only
+    };
+
+    //
+    // What one training step saw, taken from the forward pass before the weights are updated
+    // so the caller gets training accuracy without running a second forward pass
+    //
+    struct TrainStepResult {
+        double loss = 0.0;
+        std::vector<double> logits;     // output layer pre-activations before the update, as predict_logits()
+        int predicted_label = 0;
+    };
+
+    //
+    // Everything in a weights file before the parameters, see Network::save
+    //
+    struct WeightsFileHeader {
+        std::string activation;
+        std::vector<int> layer_sizes;   // input first
+    };
+
     class Network {
 
         public:
@@ -22,13 +70,16 @@ namespace ANN {
                     const WeightInitConfig& weight_config = WeightInitConfig{},
                     ANN::LearningRateConfig lr_config = ANN::LearningRateConfig{},
                     const std::string& activation = "sigmoid")
-                : input_layer(layer_sizes[0], layer_sizes[1], weight_config, activation),
-                  output_layer(layer_sizes[layer_sizes.size()-2], layer_sizes[layer_sizes.size()-1], weight_config, activation),
-                  learning_rate_config(lr_config)
+                : weight_seed_(resolve_seed(weight_config)),
+                  input_layer(layer_sizes[0], layer_sizes[1], layer_init(weight_config, weight_seed_, 0), activation),
+                  output_layer(layer_sizes[layer_sizes.size()-2], layer_sizes[layer_sizes.size()-1],
+                               layer_init(weight_config, weight_seed_, layer_sizes.size() - 2), activation),
+                  learning_rate_(lr_config.initial),
+                  activation_(activation)
             {
                 // Create hidden layers (if any)
                 for(auto i = 1; i < layer_sizes.size() - 2; i++) {
-                    layers.emplace_back(Layer(layer_sizes[i], layer_sizes[i+1], weight_config, activation));
+                    layers.emplace_back(Layer(layer_sizes[i], layer_sizes[i+1], layer_init(weight_config, weight_seed_, i), activation));
                 }
 
                 // Set up layer connectivity
@@ -49,176 +100,552 @@ namespace ANN {
                     layers.back().next_layer = std::make_shared<Layer>(output_layer);
                     output_layer.previous_layer = std::make_shared<Layer>(layers.back());
                 }
+
+                build_parameter_arena();
+            }
+
+            // Copies get their own arena, the layer views are rebound to it. They start without a
+            // profiler or perf counters, those belong to whoever attached them to the original.
+            Network(const Network& other)
+                : weight_seed_(other.weight_seed_),
+                  input_layer(other.input_layer),
+                  layers(other.layers),
+                  output_layer(other.output_layer),
+                  learning_rate_(other.learning_rate_),
+                  activation_(other.activation_),
+                  activation_kernel_(other.activation_kernel_),
+                  huge_pages_(other.huge_pages_),
+                  fused_update_(other.fused_update_),
+                  inference_mode_(other.inference_mode_)
+            {
+                build_parameter_arena();
+            }
+
+            Network& operator=(const Network& other) {
+                if (this != &other) {
+                    Network copy(other);
+                    *this = std::move(copy);
+                }
+                return *this;
             }
 
-            ~Network(){
-                layers.clear();
-            };
+            Network(Network&&) = default;
+            Network& operator=(Network&&) = default;
 
-            double train(const std::vector<double>& input_data, const int label, int epoch = 0)
+            ~Network() = default;
+
+            TrainStepResult train(const std::vector<double>& input_data, const int label)
             {
+                return train(input_data, label_to_one_hot_vector(label, static_cast<int>(output_size())));
+            }
+
+            // One SGD step towards any target, e.g. a blend of the label and a teacher network's soft outputs
+            TrainStepResult train(const std::vector<double>& input_data, const std::vector<double>& target)
+            {
+                TrainStepResult result;
+
                 // Input validation
-                if (input_data.size() != input_layer.inputs_.size()) {
-                    throw std::runtime_error("Input size mismatch: expected " + 
-                        std::to_string(input_layer.inputs_.size()) + ", got " + 
-                        std::to_string(input_data.size()));
+                validate_input(input_data);
+                if (target.size() != output_size()) {
+                    throw std::runtime_error("Target size mismatch: expected " +
+                        std::to_string(output_size()) + ", got " + std::to_string(target.size()));
                 }
-                
-                // Set input layer data
-                input_layer.inputs_ = input_data;
 
-                // Forward Pass - Chain layer outputs to next layer inputs
-                input_layer.forward();
+                // The compact inference weights would go stale with this update
+                if (inference_precision() != Precision::Double) {
+                    set_inference_precision(Precision::Double);
+                }
+                if (inference_mode_) {
+                    set_inference_mode(false);
+                }
                 
-                // Pass input layer outputs to first hidden layer (if exists)
-                if (!layers.empty()) {
-                    layers[0].inputs_ = input_layer.outputs_;
-                    
-                    // Process hidden layers
-                    for(size_t i = 0; i < layers.size(); ++i) {
-                        layers[i].forward();
-                        
-                        // Pass current layer output to next layer input
-                        if (i < layers.size() - 1) {
-                            layers[i + 1].inputs_ = layers[i].outputs_;
-                        }
+                // Forward Pass - Chain layer outputs to next layer inputs
+                {
+                    Profiling::ScopedTimer timer(profiler_, Profiling::Phase::Forward);
+                    forward_pass(input_data);
+                }
+
+                // Keep the prediction before back propagation changes the weights
+                result.logits = output_layer.pre_activations_;
+                result.predicted_label = argmax(output_layer.outputs_.data(), output_layer.outputs_.size());
+
+                // Calculate loss
+                double loss = 0.0;
+                std::vector<double> loss_gradients(output_layer.outputs_.size());
+                {
+                    Profiling::ScopedTimer timer(profiler_, Profiling::Phase::Loss);
+
+                    for (size_t i = 0; i < target.size(); ++i) {
+                        double diff = output_layer.outputs_[i] - target[i];
+                        loss += diff * diff; // Mean Squared Error
                     }
+                    loss /= target.size(); // Average the loss over all outputs
 
-                    // Pass last hidden layer output to output layer
-                    output_layer.inputs_ = layers.back().outputs_;
-                } else {
-                    // Direct connection: input -> output (no hidden layers)
-                    output_layer.inputs_ = input_layer.outputs_;
+                    // Backward Pass - Calculate loss gradients for output layer
+                    for (size_t i = 0; i < output_layer.outputs_.size(); ++i) {
+                        // MSE derivative: ∂Loss/∂output = (2/N) * (predicted - actual)
+                        // Must match the loss function which divides by N
+                        loss_gradients[i] = (2.0 / target.size()) * (output_layer.outputs_[i] - target[i]);
+                    }
                 }
                 
-                output_layer.forward();
+                if (fused_update_) {
+                    // Weights are updated layer by layer as the gradients reach them, no Update phase
+                    Profiling::ScopedTimer timer(profiler_, Profiling::Phase::Backward);
+                    fused_backward_pass(loss_gradients, learning_rate_);
+                } else {
+                    {
+                        Profiling::ScopedTimer timer(profiler_, Profiling::Phase::Backward);
+                        backward_pass(loss_gradients);
+                    }
 
-                // Calculate loss
-                double loss = 0.0;
-                std::vector<double> target = label_to_one_hot_vector(label, static_cast<int>(output_layer.outputs_.size()));
-                for (size_t i = 0; i < target.size(); ++i) {
-                    double diff = output_layer.outputs_[i] - target[i];
-                    loss += diff * diff; // Mean Squared Error
+                    Profiling::ScopedTimer timer(profiler_, Profiling::Phase::Update);
+                    apply_updates(learning_rate_);
                 }
-                loss /= target.size(); // Average the loss over all outputs
 
-                // Backward Pass - Calculate loss gradients for output layer
-                std::vector<double> loss_gradients(output_layer.outputs_.size());
-                for (size_t i = 0; i < output_layer.outputs_.size(); ++i) {
-                    // MSE derivative: ∂Loss/∂output = (2/N) * (predicted - actual)
-                    // Must match the loss function which divides by N
-                    loss_gradients[i] = (2.0 / target.size()) * (output_layer.outputs_[i] - target[i]);
+                result.loss = loss;
+                return result;
+            }
+
+            // Train on each sample in turn (plain per sample SGD), one result per sample
+            std::vector<TrainStepResult> train_batch(const std::vector<std::vector<double>>& inputs,
+                                                     const std::vector<int>& labels)
+            {
+                if (inputs.size() != labels.size()) {
+                    throw std::runtime_error("train_batch needs one label per input");
                 }
-                
-                // Start backpropagation from output layer
-                std::vector<double> gradients = output_layer.backward(loss_gradients);
-                
-                // Propagate backwards through hidden layers
-                for (size_t i = layers.size(); i > 0; --i) {
-                    gradients = layers[i-1].backward(gradients);
+
+                std::vector<TrainStepResult> results;
+                results.reserve(inputs.size());
+                for (size_t i = 0; i < inputs.size(); ++i) {
+                    results.push_back(train(inputs[i], labels[i]));
                 }
+                return results;
+            }
+
+
+
+            std::vector<double> predict_probabilities(const std::vector<double>& input_data) {
+                // Input validation
+                validate_input(input_data);
                 
-                // Finally propagate to input layer (though input layer gradients aren't used)
-                if (!layers.empty()) {
-                    input_layer.backward(gradients);
-                } else {
-                    // Direct connection case
-                    input_layer.backward(gradients);
+                forward_pass(input_data);
+
+                return output_layer.outputs_;
+            }
+
+            // Output layer values before the activation, the logits a student network is distilled from
+            std::vector<double> predict_logits(const std::vector<double>& input_data) {
+                validate_input(input_data);
+                forward_pass(input_data);
+                return output_layer.pre_activations_;
+            }
+
+            int predict_label(const std::vector<double>& input_data) {
+                auto outputs = predict_probabilities(input_data);
+                // Find index of max output 
+                return argmax(outputs.data(), outputs.size());
+            }
+
+            // Rate used by train(), the schedule is driven from outside (see Trainer)
+            void set_learning_rate(double learning_rate) { learning_rate_ = learning_rate; }
+            double learning_rate() const { return learning_rate_; }
+
+            // Attach a profiler to time the phases of train(), nullptr to detach
+            void set_profiler(Profiling::Profiler* profiler) {
+                profiler_ = profiler;
+            }
+
+            // Attach hardware counters, measured per layer for forward/backward/update, nullptr to detach
+            void set_perf_counters(Profiling::LayerPerfCounters* perf_counters) {
+                perf_counters_ = perf_counters;
+            }
+
+            // Input layer, hidden layers and output layer
+            size_t layer_count() const {
+                return layers.size() + 2;
+            }
+
+            // Layer by position, 0 is the input layer and layer_count() - 1 the output layer
+            const Layer& layer_at(size_t index) const {
+                if (index == 0) return input_layer;
+                if (index == layer_count() - 1) return output_layer;
+                return layers[index - 1];
+            }
+
+            size_t input_size() const { return input_layer.inputs_.size(); }
+            size_t output_size() const { return output_layer.outputs_.size(); }
+
+            //
+            // Batched forward pass that leaves the network untouched, so several threads can run
+            // inference on one network as long as each has its own workspace.
+            // inputs is [batch][input_size], the result is [batch][output_size]
+            //
+            const std::vector<double>& infer_batch(const double* inputs, size_t batch_size, InferenceWorkspace& workspace) const {
+                const double* layer_input = inputs;
+
+                for (size_t i = 0; i < layer_count(); ++i) {
+                    const Layer& layer = layer_at(i);
+                    workspace.next.resize(batch_size * layer.outputs_.size());
+                    layer.infer_batch(layer_input, batch_size, workspace.next.data(), workspace.compact);
+
+                    std::swap(workspace.current, workspace.next);
+                    layer_input = workspace.current.data();
                 }
 
-                // Update learning rate config
-                learning_rate_config.update(epoch);
-                double lr = learning_rate_config.get();
+                return workspace.current;
+            }
 
-                // Update Weights and Biases for all layers
-                // Update input layer
-                for (size_t i = 0; i < input_layer.weights_.size(); ++i) {
-                    input_layer.weights_[i] -= lr * input_layer.weight_gradients_[i];
+            // Sizes of every layer, input first, as passed to the constructor
+            std::vector<int> layer_sizes() const {
+                std::vector<int> sizes{static_cast<int>(input_size())};
+                for (size_t i = 0; i < layer_count(); ++i) {
+                    sizes.push_back(static_cast<int>(layer_at(i).outputs_.size()));
                 }
-                for (size_t i = 0; i < input_layer.biases_.size(); ++i) {
-                    input_layer.biases_[i] -= lr * input_layer.bias_gradients_[i];
+                return sizes;
+            }
+
+            const std::string& activation() const { return activation_; }
+
+            //
+            // Every weight and bias of the network, layer after layer, and their gradients in the same layout.
+            // Spaces between layers (cache line padding) are always zero.
+            //
+            std::span<double> parameters() { return arena_->parameters(); }
+            std::span<double> gradients() { return arena_->gradients(); }
+            std::span<const double> parameters() const { return std::as_const(*arena_).parameters(); }
+            std::span<const double> gradients() const { return std::as_const(*arena_).gradients(); }
+
+            // Back the parameter arena with transparent huge pages, worthwhile for wide networks
+            void set_huge_pages(bool enabled) {
+                if (enabled != huge_pages_) {
+                    huge_pages_ = enabled;
+                    build_parameter_arena();
                 }
-                // Update hidden layers
-                for (auto& layer : layers) {
-                    for (size_t i = 0; i < layer.weights_.size(); ++i) {
-                        layer.weights_[i] -= lr * layer.weight_gradients_[i];
-                    }
-                    for (size_t i = 0; i < layer.biases_.size(); ++i) {
-                        layer.biases_[i] -= lr * layer.bias_gradients_[i];
+            }
+
+            //
+            // Fold the SGD step into the backward pass, each layer updates its weights straight from
+            // input × delta. Halves the parameter sized memory traffic per sample and drops the
+            // gradient block from the arena, so gradients() is empty while this is on.
+            //
+            void set_fused_update(bool enabled) {
+                if (enabled != fused_update_) {
+                    fused_update_ = enabled;
+                    build_parameter_arena();
+                }
+            }
+
+            bool fused_update() const { return fused_update_; }
+
+            //
+            // Let the first layer skip zero inputs when at most threshold of them are non-zero,
+            // e.g. 0.4 for normalised digit images that are around 80% background. 0 turns it off.
+            //
+            void set_sparse_input_threshold(double threshold) {
+                input_layer.set_sparse_input_threshold(threshold);
+            }
+
+            //
+            // Serve infer_batch (and so evaluate) from float16 or bfloat16 copies of the weights with
+            // float accumulation. Takes a snapshot of the current weights; the next train() step
+            // goes back to Double, set it again once training is done. The double parameters are kept,
+            // only the weights inference reads shrink, not the memory the network holds.
+            //
+            void set_inference_precision(Precision precision) {
+                for (size_t i = 0; i < layer_count(); ++i) {
+                    mutable_layer_at(i).set_inference_precision(precision);
+                }
+            }
+
+            Precision inference_precision() const { return input_layer.inference_precision(); }
+
+            // Evaluate the activation (and its derivative) with an exact or approximate kernel, for training and inference
+            void set_activation_kernel(ActivationKernel kernel) {
+                for (size_t i = 0; i < layer_count(); ++i) {
+                    mutable_layer_at(i).set_activation(get_activation(activation_, kernel), get_activation_derivative(activation_, kernel),
+                                                       get_activation_output_derivative(activation_));
+                }
+                activation_kernel_ = kernel;
+            }
+
+            ActivationKernel activation_kernel() const { return activation_kernel_; }
+
+            //
+            // For a network that only predicts: layers keep no pre-activations (derivatives come from
+            // the outputs anyway) and the arena drops its gradient block, so gradients() is empty.
+            // The output layer's few pre-activations stay, they are what predict_logits() returns.
+            // The next train() leaves inference mode again.
+            //
+            void set_inference_mode(bool enabled) {
+                if (enabled != inference_mode_) {
+                    inference_mode_ = enabled;
+                    for (size_t i = 0; i + 1 < layer_count(); ++i) {
+                        mutable_layer_at(i).set_inference_mode(enabled);
                     }
+                    build_parameter_arena();
+                }
+            }
+
+            bool inference_mode() const { return inference_mode_; }
+
+            // Seed the weights were drawn with, set weight_init.seed to this to reproduce them
+            uint64_t weight_seed() const { return weight_seed_; }
+
+            //
+            // Binary weights file: magic, format version, activation name, layer sizes,
+            // then the weights and biases of each layer in order, all little endian as in memory.
+            // Only the parameters are stored, the learning rate schedule comes from the config.
+            //
+            static constexpr char WEIGHTS_MAGIC[4] = {'A', 'N', 'N', 'W'};
+            static constexpr uint32_t WEIGHTS_VERSION = 1;
+
+            bool save(const std::string& filename) const {
+                std::ofstream file(filename, std::ios::binary);
+                if (!file.is_open()) {
+                    return false;
+                }
+
+                write_weights_header(file, {activation_, layer_sizes()});
+                for (size_t i = 0; i < layer_count(); ++i) {
+                    const Layer& layer = layer_at(i);
+                    file.write(reinterpret_cast<const char*>(layer.weights_.data()), layer.weights_.size() * sizeof(double));
+                    file.write(reinterpret_cast<const char*>(layer.biases_.data()), layer.biases_.size() * sizeof(double));
                 }
-                // Update output layer
-                for (size_t i = 0; i < output_layer.weights_.size(); ++i) {
-                    output_layer.weights_[i] -= lr * output_layer.weight_gradients_[i];
+                return file.good();
+            }
+
+            static Network load(const std::string& filename, ANN::LearningRateConfig lr_config = ANN::LearningRateConfig{}) {
+                std::ifstream file(filename, std::ios::binary);
+                if (!file.is_open()) {
+                    throw std::runtime_error("Could not open weights file: " + filename);
+                }
+
+                auto header = read_weights_header(file, filename);
+                Network network(header.layer_sizes, WeightInitConfig{}, lr_config, header.activation);
+                for (size_t i = 0; i < network.layer_count(); ++i) {
+                    Layer& layer = network.mutable_layer_at(i);
+                    file.read(reinterpret_cast<char*>(layer.weights_.data()), layer.weights_.size() * sizeof(double));
+                    file.read(reinterpret_cast<char*>(layer.biases_.data()), layer.biases_.size() * sizeof(double));
                 }
-                for (size_t i = 0; i < output_layer.biases_.size(); ++i) {
-                    output_layer.biases_[i] -= lr * output_layer.bias_gradients_[i];
+                if (!file) {
+                    throw std::runtime_error("Truncated weights file: " + filename);
                 }
+                return network;
+            }
+
+            // Header of the weights file, shared with StaticNetwork
+            static void write_weights_header(std::ostream& file, const WeightsFileHeader& header) {
+                auto write_u32 = [&file](uint32_t value) {
+                    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+                };
 
-                return loss;  // Return the calculated loss for this training sample
+                file.write(WEIGHTS_MAGIC, sizeof(WEIGHTS_MAGIC));
+                write_u32(WEIGHTS_VERSION);
+                write_u32(static_cast<uint32_t>(header.activation.size()));
+                file.write(header.activation.data(), header.activation.size());
+
+                write_u32(static_cast<uint32_t>(header.layer_sizes.size()));
+                for (int size : header.layer_sizes) {
+                    write_u32(static_cast<uint32_t>(size));
+                }
             }
 
+            // Reads and checks the header, leaving file at the first weight. Throws on a bad file.
+            static WeightsFileHeader read_weights_header(std::istream& file, const std::string& filename) {
+                auto read_u32 = [&file]() {
+                    uint32_t value = 0;
+                    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+                    return value;
+                };
 
+                char magic[4] = {};
+                file.read(magic, sizeof(magic));
+                if (!file || std::string(magic, 4) != std::string(WEIGHTS_MAGIC, 4)) {
+                    throw std::runtime_error("Not a weights file: " + filename);
+                }
+                if (uint32_t version = read_u32(); version != WEIGHTS_VERSION) {
+                    throw std::runtime_error("Unsupported weights file version " + std::to_string(version) + ": " + filename);
+                }
 
-            std::vector<double> predict_probabilities(const std::vector<double>& input_data) {
-                // Input validation
-                if (input_data.size() != input_layer.inputs_.size()) {
-                    throw std::runtime_error("Input size mismatch: expected " + 
-                        std::to_string(input_layer.inputs_.size()) + ", got " + 
-                        std::to_string(input_data.size()));
+                WeightsFileHeader header;
+                header.activation.resize(read_u32());
+                file.read(header.activation.data(), header.activation.size());
+
+                header.layer_sizes.resize(read_u32());
+                for (auto& size : header.layer_sizes) {
+                    size = static_cast<int>(read_u32());
                 }
-                
-                // Set input layer data
-                input_layer.inputs_ = input_data;
+                if (!file || header.layer_sizes.size() < 3) {
+                    throw std::runtime_error("Corrupt weights file header: " + filename);
+                }
+                return header;
+            }
 
-                // Forward Pass - Chain layer outputs to next layer inputs
+    private:
+        // One seed for the whole network, drawn here if the config does not fix one
+        static uint64_t resolve_seed(const WeightInitConfig& config) {
+            if (config.seed) {
+                return *config.seed;
+            }
+            std::random_device device;
+            return (static_cast<uint64_t>(device()) << 32) | device();
+        }
+
+        // Each layer draws from its own stream of the network seed
+        static WeightInitConfig layer_init(WeightInitConfig config, uint64_t seed, uint64_t layer_index) {
+            config.seed = seed;
+            config.stream = layer_index;
+            return config;
+        }
+
+        // Move the parameters of every layer into one network wide arena
+        void build_parameter_arena() {
+            size_t capacity = 0;
+            for (size_t i = 0; i < layer_count(); ++i) {
+                capacity += layer_at(i).parameter_capacity();
+            }
+
+            auto arena = std::make_shared<ParameterArena>(capacity, huge_pages_, !fused_update_ && !inference_mode_);
+            for (size_t i = 0; i < layer_count(); ++i) {
+                mutable_layer_at(i).bind_parameters(arena);
+            }
+            arena_ = std::move(arena);
+        }
+
+        Layer& mutable_layer_at(size_t index) {
+            if (index == 0) return input_layer;
+            if (index == layer_count() - 1) return output_layer;
+            return layers[index - 1];
+        }
+
+        void validate_input(const std::vector<double>& input_data) const {
+            if (input_data.size() != input_layer.inputs_.size()) {
+                throw std::runtime_error("Input size mismatch: expected " + 
+                    std::to_string(input_layer.inputs_.size()) + ", got " + 
+                    std::to_string(input_data.size()));
+            }
+        }
+
+        void forward_pass(const std::vector<double>& input_data) {
+            // Set input layer data
+            input_layer.inputs_ = input_data;
+
+            {
+                Profiling::ScopedCounters counters(perf_counters_, 0, Profiling::PerfPhase::Forward);
                 input_layer.forward();
+            }
+            
+            // Pass input layer outputs to first hidden layer (if exists)
+            if (!layers.empty()) {
+                layers[0].inputs_ = input_layer.outputs_;
                 
-                // Pass input layer outputs to first hidden layer (if exists)
-                if (!layers.empty()) {
-                    layers[0].inputs_ = input_layer.outputs_;
-                    
-                    // Process hidden layers - use size_t for loop counter
-                    for(size_t i = 0; i < layers.size(); ++i) {
+                // Process hidden layers - use size_t for loop counter
+                for(size_t i = 0; i < layers.size(); ++i) {
+                    {
+                        Profiling::ScopedCounters counters(perf_counters_, i + 1, Profiling::PerfPhase::Forward);
                         layers[i].forward();
-                        
-                        // Pass current layer output to next layer input
-                        if (i < layers.size() - 1) {
-                            layers[i + 1].inputs_ = layers[i].outputs_;
-                        }
                     }
                     
-                    // Pass last hidden layer output to output layer
-                    output_layer.inputs_ = layers.back().outputs_;
-                } else {
-                    // Direct connection: input -> output (no hidden layers)
-                    output_layer.inputs_ = input_layer.outputs_;
+                    // Pass current layer output to next layer input
+                    if (i < layers.size() - 1) {
+                        layers[i + 1].inputs_ = layers[i].outputs_;
+                    }
                 }
                 
-                output_layer.forward();
+                // Pass last hidden layer output to output layer
+                output_layer.inputs_ = layers.back().outputs_;
+            } else {
+                // Direct connection: input -> output (no hidden layers)
+                output_layer.inputs_ = input_layer.outputs_;
+            }
+            
+            Profiling::ScopedCounters counters(perf_counters_, layer_count() - 1, Profiling::PerfPhase::Forward);
+            output_layer.forward();
+        }
 
-                return output_layer.outputs_;
+        void backward_pass(const std::vector<double>& loss_gradients) {
+            // Start backpropagation from output layer
+            std::vector<double> gradients;
+            {
+                Profiling::ScopedCounters counters(perf_counters_, layer_count() - 1, Profiling::PerfPhase::Backward);
+                gradients = output_layer.backward(loss_gradients);
+            }
+            
+            // Propagate backwards through hidden layers
+            for (size_t i = layers.size(); i > 0; --i) {
+                Profiling::ScopedCounters counters(perf_counters_, i, Profiling::PerfPhase::Backward);
+                gradients = layers[i-1].backward(gradients);
             }
+            
+            // Finally propagate to input layer (though input layer gradients aren't used)
+            Profiling::ScopedCounters counters(perf_counters_, 0, Profiling::PerfPhase::Backward);
+            input_layer.backward(gradients);
+        }
 
-            int predict_label(const std::vector<double>& input_data) {
-                auto outputs = predict_probabilities(input_data);
-                // Find index of max output 
-                // TODO utility function?
-                int predicted_label = 0;
-                double max_value = outputs[0];
-                for (size_t i = 1; i < outputs.size(); ++i) {
-                    if (outputs[i] > max_value) {
-                        max_value = outputs[i];
-                        predicted_label = static_cast<int>(i);
-                    }
+        void fused_backward_pass(const std::vector<double>& loss_gradients, double lr) {
+            std::vector<double> gradients;
+            {
+                Profiling::ScopedCounters counters(perf_counters_, layer_count() - 1, Profiling::PerfPhase::Backward);
+                gradients = output_layer.backward_and_update(loss_gradients, lr);
+            }
+
+            for (size_t i = layers.size(); i > 0; --i) {
+                Profiling::ScopedCounters counters(perf_counters_, i, Profiling::PerfPhase::Backward);
+                gradients = layers[i-1].backward_and_update(gradients, lr);
+            }
+
+            Profiling::ScopedCounters counters(perf_counters_, 0, Profiling::PerfPhase::Backward);
+            input_layer.backward_and_update(gradients, lr);
+        }
+
+        static void apply_layer_update(Layer& layer, double lr) {
+            for (size_t i = 0; i < layer.weights_.size(); ++i) {
+                layer.weights_[i] -= lr * layer.weight_gradients_[i];
+            }
+            for (size_t i = 0; i < layer.biases_.size(); ++i) {
+                layer.biases_[i] -= lr * layer.bias_gradients_[i];
+            }
+        }
+
+        void apply_updates(double lr) {
+            // One pass over the whole arena, unless the counters need the time split per layer
+            if (!perf_counters_) {
+                auto params = arena_->parameters();
+                auto grads = arena_->gradients();
+                for (size_t i = 0; i < params.size(); ++i) {
+                    params[i] -= lr * grads[i];
                 }
-                return predicted_label;
+                return;
             }
+
+            // Update Weights and Biases for all layers
+            {
+                Profiling::ScopedCounters counters(perf_counters_, 0, Profiling::PerfPhase::Update);
+                apply_layer_update(input_layer, lr);
+            }
+            for (size_t i = 0; i < layers.size(); ++i) {
+                Profiling::ScopedCounters counters(perf_counters_, i + 1, Profiling::PerfPhase::Update);
+                apply_layer_update(layers[i], lr);
+            }
+            Profiling::ScopedCounters counters(perf_counters_, layer_count() - 1, Profiling::PerfPhase::Update);
+            apply_layer_update(output_layer, lr);
+        }
+
     private:
+        uint64_t weight_seed_;
         Layer input_layer;
         std::vector<Layer> layers;
         Layer output_layer;
-        ANN::LearningRateConfig learning_rate_config;
+        double learning_rate_;
+        std::string activation_;
+        ActivationKernel activation_kernel_ = ActivationKernel::Exact;
+        bool huge_pages_ = false;
+        bool fused_update_ = false;
+        bool inference_mode_ = false;
+        std::shared_ptr<ParameterArena> arena_;
+        Profiling::Profiler* profiler_ = nullptr;
+        Profiling::LayerPerfCounters* perf_counters_ = nullptr;
     };
 
 } // namespace NN
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "../activations/activations.h"
+#include "networks.hpp"
+
+namespace ANN {
+
+    //
+    // Fully connected layer with its sizes fixed at compile time. Weights are laid out as in
+    // Layer, one row of Inputs weights per output neuron, so they copy across unchanged.
+    //
+    template <size_t Inputs, size_t Outputs>
+    struct StaticLayer {
+        static constexpr size_t input_size = Inputs;
+        static constexpr size_t output_size = Outputs;
+
+        alignas(64) std::array<double, Inputs * Outputs> weights{};
+        alignas(64) std::array<double, Outputs> biases{};
+
+        // z = W·input + b, same summation order as Layer::infer_batch
+        void pre_activations(const std::array<double, Inputs>& input, std::array<double, Outputs>& z) const {
+            for (size_t output_index = 0; output_index < Outputs; ++output_index) {
+                const double* weight_row = &weights[output_index * Inputs];
+
+                double sum = 0.0;
+                for (size_t input_index = 0; input_index < Inputs; ++input_index) {
+                    sum += input[input_index] * weight_row[input_index];
+                }
+                z[output_index] = sum + biases[output_index];
+            }
+        }
+    };
+
+    //
+    // Inference only network with the topology as template arguments, e.g. StaticNetwork<784, 128, 64, 10>.
+    // Every loop bound is a constant and each layer is one std::array block, no heap and no size checks
+    // on the way through. Reads and writes the same weights file as Network, and can be built from one.
+    // The digit topology is around 870KB, create it with std::make_unique rather than on the stack.
+    //
+    template <size_t... Sizes>
+    class StaticNetwork {
+        static_assert(sizeof...(Sizes) >= 3, "StaticNetwork needs an input, at least one hidden and an output size");
+
+    public:
+        static constexpr std::array<size_t, sizeof...(Sizes)> sizes{Sizes...};
+        static constexpr size_t layer_count = sizeof...(Sizes) - 1;
+        static constexpr size_t input_size = sizes.front();
+        static constexpr size_t output_size = sizes.back();
+
+        using Input = std::array<double, input_size>;
+        using Output = std::array<double, output_size>;
+
+        // Zero weights, fill them with load() or layer<I>()
+        explicit StaticNetwork(const std::string& activation = "sigmoid") {
+            set_activation(activation);
+        }
+
+        // Copy the weights of a dynamic network with the same topology
+        explicit StaticNetwork(const Network& network) {
+            if (network.layer_sizes() != layer_sizes()) {
+                throw std::runtime_error("Network topology does not match the StaticNetwork sizes");
+            }
+            set_activation(network.activation());
+            copy_from(network, std::make_index_sequence<layer_count>{});
+        }
+
+        void infer(const Input& input, Output& output) const {
+            forward<0>(input, output);
+        }
+
+        // Predicted label, the largest output
+        int classify(const Input& input) const {
+            Output output;
+            infer(input, output);
+            return argmax(output.data(), output.size());
+        }
+
+        bool save(const std::string& filename) const {
+            std::ofstream file(filename, std::ios::binary);
+            if (!file.is_open()) {
+                return false;
+            }
+
+            Network::write_weights_header(file, {activation_, layer_sizes()});
+            for_each_layer([&file](const auto& layer) {
+                file.write(reinterpret_cast<const char*>(layer.weights.data()), sizeof(layer.weights));
+                file.write(reinterpret_cast<const char*>(layer.biases.data()), sizeof(layer.biases));
+            });
+            return file.good();
+        }
+
+        // Replace the weights and activation with those of a weights file, throws if the file's
+        // topology differs from Sizes
+        void load(const std::string& filename) {
+            std::ifstream file(filename, std::ios::binary);
+            if (!file.is_open()) {
+                throw std::runtime_error("Could not open weights file: " + filename);
+            }
+
+            auto header = Network::read_weights_header(file, filename);
+            if (header.layer_sizes != layer_sizes()) {
+                throw std::runtime_error("Weights file topology does not match the StaticNetwork sizes: " + filename);
+            }
+            set_activation(header.activation);
+
+            for_each_layer([&file](auto& layer) {
+                file.read(reinterpret_cast<char*>(layer.weights.data()), sizeof(layer.weights));
+                file.read(reinterpret_cast<char*>(layer.biases.data()), sizeof(layer.biases));
+            });
+            if (!file) {
+                throw std::runtime_error("Truncated weights file: " + filename);
+            }
+        }
+
+        template <size_t Index>
+        auto& layer() { return std::get<Index>(layers_); }
+        template <size_t Index>
+        const auto& layer() const { return std::get<Index>(layers_); }
+
+        const std::string& activation() const { return activation_; }
+
+        static std::vector<int> layer_sizes() {
+            return {static_cast<int>(Sizes)...};
+        }
+
+    private:
+        template <size_t... Index>
+        static auto make_layers(std::index_sequence<Index...>)
+            -> std::tuple<StaticLayer<sizes[Index], sizes[Index + 1]>...>;
+
+        using Layers = decltype(make_layers(std::make_index_sequence<layer_count>{}));
+
+        void set_activation(const std::string& activation) {
+            if (activation != "sigmoid" && activation != "relu") {
+                throw std::runtime_error("Unknown activation function: " + activation);
+            }
+            activation_ = activation;
+            relu_ = activation == "relu";
+        }
+
+        // One layer per call, the intermediate values live on the stack
+        template <size_t Index>
+        void forward(const std::array<double, sizes[Index]>& input, Output& output) const {
+            if constexpr (Index + 1 == layer_count) {
+                std::get<Index>(layers_).pre_activations(input, output);
+                activate(output);
+            } else {
+                std::array<double, sizes[Index + 1]> next;
+                std::get<Index>(layers_).pre_activations(input, next);
+                activate(next);
+                forward<Index + 1>(next, output);
+            }
+        }
+
+        // Same functions as Layer so both networks give identical outputs
+        template <size_t Count>
+        void activate(std::array<double, Count>& values) const {
+            if (relu_) {
+                for (double& value : values) value = relu(value);
+            } else {
+                for (double& value : values) value = sigmoid(value);
+            }
+        }
+
+        template <typename Visit>
+        void for_each_layer(Visit visit) {
+            std::apply([&visit](auto&... layer) { (visit(layer), ...); }, layers_);
+        }
+        template <typename Visit>
+        void for_each_layer(Visit visit) const {
+            std::apply([&visit](const auto&... layer) { (visit(layer), ...); }, layers_);
+        }
+
+        template <size_t... Index>
+        void copy_from(const Network& network, std::index_sequence<Index...>) {
+            (copy_layer(network.layer_at(Index), std::get<Index>(layers_)), ...);
+        }
+
+        template <typename Target>
+        static void copy_layer(const Layer& source, Target& target) {
+            std::copy(source.weights_.begin(), source.weights_.end(), target.weights.begin());
+            std::copy(source.biases_.begin(), source.biases_.end(), target.biases.begin());
+        }
+
+        Layers layers_;
+        std::string activation_;
+        bool relu_ = false;
+    };
+
+} // namespace ANN
@@ -0,0 +1,214 @@
+#include "perf_counters.hpp"
+
+#include <fstream>
+#include <iomanip>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ANN {
+namespace Profiling {
+
+namespace {
+
+    double safe_ratio(double numerator, double denominator) {
+        return denominator > 0.0 ? numerator / denominator : 0.0;
+    }
+
+#if defined(__linux__)
+    struct CounterSpec {
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+
+    // Same order as the Counter enum
+    constexpr std::array<CounterSpec, COUNTER_COUNT> COUNTER_SPECS = {{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    }};
+
+    int open_counter(const CounterSpec& spec, int group_fd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = spec.type;
+        attr.config = spec.config;
+        attr.disabled = group_fd == -1 ? 1 : 0;    // leader starts disabled, enables the whole group
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+
+        // this thread, any cpu
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+#endif
+
+} // namespace
+
+double CounterValues::ipc() const {
+    return safe_ratio(static_cast<double>((*this)[Counter::Instructions]),
+                      static_cast<double>((*this)[Counter::Cycles]));
+}
+
+double CounterValues::cache_miss_rate() const {
+    return safe_ratio(static_cast<double>((*this)[Counter::CacheMisses]),
+                      static_cast<double>((*this)[Counter::CacheReferences]));
+}
+
+double CounterValues::cache_mpki() const {
+    return 1000.0 * safe_ratio(static_cast<double>((*this)[Counter::CacheMisses]),
+                               static_cast<double>((*this)[Counter::Instructions]));
+}
+
+double CounterValues::branch_miss_rate() const {
+    return safe_ratio(static_cast<double>((*this)[Counter::BranchMisses]),
+                      static_cast<double>((*this)[Counter::Branches]));
+}
+
+PerfCounterGroup::PerfCounterGroup() {
+    fds_.fill(-1);
+
+#if defined(__linux__)
+    fds_[0] = open_counter(COUNTER_SPECS[0], -1);
+    if (fds_[0] == -1) {
+        error_ = std::string("perf_event_open failed: ") + std::strerror(errno)
+               + " (check /proc/sys/kernel/perf_event_paranoid)";
+        return;
+    }
+
+    // The remaining counters are optional, a PMU without e.g. cache events still gives IPC
+    for (std::size_t i = 1; i < COUNTER_COUNT; ++i) {
+        fds_[i] = open_counter(COUNTER_SPECS[i], fds_[0]);
+    }
+
+    ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    available_ = true;
+#else
+    error_ = "hardware performance counters are only supported on Linux";
+#endif
+}
+
+PerfCounterGroup::~PerfCounterGroup() {
+#if defined(__linux__)
+    if (fds_[0] != -1) {
+        ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+    // close members before the leader
+    for (std::size_t i = COUNTER_COUNT; i > 0; --i) {
+        if (fds_[i - 1] != -1) {
+            close(fds_[i - 1]);
+        }
+    }
+#endif
+}
+
+CounterValues PerfCounterGroup::read() const {
+    CounterValues result;
+
+#if defined(__linux__)
+    if (!available_) {
+        return result;
+    }
+
+    // PERF_FORMAT_GROUP | PERF_FORMAT_ID layout: nr, then {value, id} per opened counter
+    struct {
+        std::uint64_t nr;
+        struct { std::uint64_t value; std::uint64_t id; } entries[COUNTER_COUNT];
+    } buffer;
+
+    if (::read(fds_[0], &buffer, sizeof(buffer)) <= 0) {
+        return result;
+    }
+
+    // Opened counters appear in open order, skipping the ones that failed
+    std::size_t entry = 0;
+    for (std::size_t i = 0; i < COUNTER_COUNT && entry < buffer.nr; ++i) {
+        if (fds_[i] != -1) {
+            result.values[i] = buffer.entries[entry++].value;
+        }
+    }
+#endif
+
+    return result;
+}
+
+LayerPerfCounters::LayerPerfCounters(std::size_t layer_count)
+    : totals_(layer_count)
+{
+}
+
+void LayerPerfCounters::add(std::size_t layer, PerfPhase phase, const CounterValues& start, const CounterValues& end) {
+    auto& total = totals_[layer][static_cast<std::size_t>(phase)];
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+        total.values[i] += end.values[i] - start.values[i];
+    }
+}
+
+const CounterValues& LayerPerfCounters::totals(std::size_t layer, PerfPhase phase) const {
+    return totals_[layer][static_cast<std::size_t>(phase)];
+}
+
+void LayerPerfCounters::print_report(std::ostream& out) const {
+    if (!is_available()) {
+        out << "Hardware counters unavailable: " << error() << std::endl;
+        return;
+    }
+
+    out << "=== HARDWARE COUNTERS (per layer) ===" << std::endl;
+    out << std::left << std::setw(7) << "Layer" << std::setw(10) << "Phase"
+        << std::right << std::setw(16) << "Cycles" << std::setw(16) << "Instructions"
+        << std::setw(8) << "IPC" << std::setw(12) << "LLC miss%" << std::setw(10) << "LLC MPKI"
+        << std::setw(12) << "Br miss%" << std::endl;
+
+    for (std::size_t layer = 0; layer < totals_.size(); ++layer) {
+        for (std::size_t phase = 0; phase < PERF_PHASE_COUNT; ++phase) {
+            const auto& values = totals_[layer][phase];
+            out << std::left << std::setw(7) << layer << std::setw(10) << PERF_PHASE_NAMES[phase]
+                << std::right << std::setw(16) << values[Counter::Cycles]
+                << std::setw(16) << values[Counter::Instructions]
+                << std::fixed << std::setprecision(2)
+                << std::setw(8) << values.ipc()
+                << std::setw(12) << values.cache_miss_rate() * 100.0
+                << std::setw(10) << values.cache_mpki()
+                << std::setw(12) << values.branch_miss_rate() * 100.0 << std::endl;
+        }
+    }
+    out << "=====================================" << std::endl;
+}
+
+bool LayerPerfCounters::save_csv(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "layer,phase,cycles,instructions,cache_references,cache_misses,branches,branch_misses,"
+         << "ipc,cache_miss_rate,cache_mpki,branch_miss_rate\n";
+
+    for (std::size_t layer = 0; layer < totals_.size(); ++layer) {
+        for (std::size_t phase = 0; phase < PERF_PHASE_COUNT; ++phase) {
+            const auto& values = totals_[layer][phase];
+            file << layer << "," << PERF_PHASE_NAMES[phase];
+            for (auto value : values.values) {
+                file << "," << value;
+            }
+            file << "," << values.ipc() << "," << values.cache_miss_rate()
+                 << "," << values.cache_mpki() << "," << values.branch_miss_rate() << "\n";
+        }
+    }
+    return true;
+}
+
+} // namespace Profiling
+} // namespace ANN
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ANN {
+namespace Profiling {
+
+    //
+    // Hardware counters we read, in the order they are opened in the perf group
+    //
+    enum class Counter : std::size_t {
+        Cycles = 0,
+        Instructions,
+        CacheReferences,    // last level cache accesses
+        CacheMisses,        // last level cache misses
+        Branches,
+        BranchMisses,
+        Count
+    };
+
+    inline constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(Counter::Count);
+
+    struct CounterValues {
+        std::array<std::uint64_t, COUNTER_COUNT> values{};
+
+        std::uint64_t operator[](Counter counter) const {
+            return values[static_cast<std::size_t>(counter)];
+        }
+
+        double ipc() const;
+        double cache_miss_rate() const;     // LLC misses / LLC references
+        double cache_mpki() const;          // LLC misses per 1000 instructions
+        double branch_miss_rate() const;    // branch misses / branches
+    };
+
+    //
+    // Which part of Network::train a measurement belongs to
+    //
+    enum class PerfPhase : std::size_t {
+        Forward = 0,
+        Backward,
+        Update,
+        Count
+    };
+
+    inline constexpr std::size_t PERF_PHASE_COUNT = static_cast<std::size_t>(PerfPhase::Count);
+
+    inline constexpr std::array<const char*, PERF_PHASE_COUNT> PERF_PHASE_NAMES = {
+        "forward", "backward", "update"
+    };
+
+    //
+    // Linux perf_event_open counter group for the calling thread, counting user space only.
+    // Counters run continuously once opened, regions are measured by reading before and after.
+    // On other platforms, or when the kernel refuses (perf_event_paranoid, containers),
+    // is_available() is false and every call is a no-op.
+    //
+    class PerfCounterGroup {
+    public:
+        PerfCounterGroup();
+        ~PerfCounterGroup();
+
+        PerfCounterGroup(const PerfCounterGroup&) = delete;
+        PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+        bool is_available() const { return available_; }
+        const std::string& error() const { return error_; }
+
+        // Snapshot of the running totals, zeros when unavailable
+        CounterValues read() const;
+
+    private:
+        std::array<int, COUNTER_COUNT> fds_;
+        bool available_ = false;
+        std::string error_;
+    };
+
+    //
+    // Per layer, per phase accumulation of counter deltas for the whole run
+    //
+    class LayerPerfCounters {
+    public:
+        explicit LayerPerfCounters(std::size_t layer_count);
+
+        bool is_available() const { return group_.is_available(); }
+        const std::string& error() const { return group_.error(); }
+
+        CounterValues read() const { return group_.read(); }
+        void add(std::size_t layer, PerfPhase phase, const CounterValues& start, const CounterValues& end);
+
+        const CounterValues& totals(std::size_t layer, PerfPhase phase) const;
+        std::size_t layer_count() const { return totals_.size(); }
+
+        // Human readable table of IPC and miss rates per layer and phase
+        void print_report(std::ostream& out) const;
+
+        // One row per layer and phase with raw counts and derived rates
+        bool save_csv(const std::string& filename) const;
+
+    private:
+        PerfCounterGroup group_;
+        std::vector<std::array<CounterValues, PERF_PHASE_COUNT>> totals_;
+    };
+
+    //
+    // RAII region, does nothing when no counters are attached
+    //
+    class ScopedCounters {
+    public:
+        ScopedCounters(LayerPerfCounters* counters, std::size_t layer, PerfPhase phase)
+            : counters_(counters), layer_(layer), phase_(phase)
+        {
+            if (counters_) {
+                start_ = counters_->read();
+            }
+        }
+
+        ~ScopedCounters() {
+            if (counters_) {
+                counters_->add(layer_, phase_, start_, counters_->read());
+            }
+        }
+
+        ScopedCounters(const ScopedCounters&) = delete;
+        ScopedCounters& operator=(const ScopedCounters&) = delete;
+
+    private:
+        LayerPerfCounters* counters_;
+        std::size_t layer_;
+        PerfPhase phase_;
+        CounterValues start_;
+    };
+
+} // namespace Profiling
+} // namespace ANN
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace ANN {
+namespace Profiling {
+
+    //
+    // Phases of a training run that we want to account time against
+    //
+    enum class Phase : std::size_t {
+        DataLoad = 0,   // reading files from disk
+        Decode,         // turning file bytes into pixels
+        Normalise,      // scaling pixel values
+        Shuffle,        // reordering the training instances
+        Augment,        // training waiting on augmented samples
+        Forward,        // forward pass through all layers
+        Loss,           // loss and output gradient calculation
+        Backward,       // back propagation through all layers
+        Update,         // applying gradients to weights and biases
+        Evaluation,     // inference over the test set
+        Count
+    };
+
+    inline constexpr std::size_t PHASE_COUNT = static_cast<std::size_t>(Phase::Count);
+
+    inline constexpr std::array<const char*, PHASE_COUNT> PHASE_NAMES = {
+        "data_load", "decode", "normalise", "shuffle", "augment",
+        "forward", "loss", "backward", "update", "evaluation"
+    };
+
+    //
+    // Accumulates elapsed time per phase, reset at the start of each stage/epoch
+    //
+    class Profiler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        void add(Phase phase, Clock::duration elapsed) {
+            totals_[static_cast<std::size_t>(phase)] += elapsed;
+        }
+
+        void add_samples(std::size_t count) {
+            samples_ += count;
+        }
+
+        // Fold in the totals of another profiler, e.g. one per loader thread
+        void merge(const Profiler& other) {
+            for (std::size_t i = 0; i < PHASE_COUNT; ++i) {
+                totals_[i] += other.totals_[i];
+            }
+            samples_ += other.samples_;
+        }
+
+        void reset() {
+            totals_.fill(Clock::duration::zero());
+            samples_ = 0;
+        }
+
+        double milliseconds(Phase phase) const {
+            return std::chrono::duration<double, std::milli>(totals_[static_cast<std::size_t>(phase)]).count();
+        }
+
+        std::size_t samples() const {
+            return samples_;
+        }
+
+    private:
+        std::array<Clock::duration, PHASE_COUNT> totals_{};
+        std::size_t samples_ = 0;
+    };
+
+    //
+    // RAII timer, does nothing (no clock reads) when no profiler is attached
+    //
+    class ScopedTimer {
+    public:
+        ScopedTimer(Profiler* profiler, Phase phase)
+            : profiler_(profiler), phase_(phase)
+        {
+            if (profiler_) {
+                start_ = Profiler::Clock::now();
+            }
+        }
+
+        ~ScopedTimer() {
+            if (profiler_) {
+                profiler_->add(phase_, Profiler::Clock::now() - start_);
+            }
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Profiler* profiler_;
+        Phase phase_;
+        Profiler::Clock::time_point start_{};
+    };
+
+    //
+    // Writes one row per stage (load, each training epoch, test) with the per phase breakdown
+    //
+    class ProfileCsvWriter {
+    public:
+        explicit ProfileCsvWriter(const std::string& filename)
+            : file_(filename)
+        {
+            if (file_.is_open()) {
+                file_ << "stage,epoch";
+                for (const auto* name : PHASE_NAMES) {
+                    file_ << "," << name << "_ms";
+                }
+                file_ << ",ms_per_epoch,samples,samples_per_sec\n";
+            }
+        }
+
+        bool is_open() const {
+            return file_.is_open();
+        }
+
+        void write_row(const std::string& stage, int epoch, const Profiler& profiler, double wall_ms) {
+            if (!file_.is_open()) {
+                return;
+            }
+
+            file_ << stage << "," << epoch;
+            for (std::size_t i = 0; i < PHASE_COUNT; ++i) {
+                file_ << "," << profiler.milliseconds(static_cast<Phase>(i));
+            }
+
+            double samples_per_sec = wall_ms > 0.0 ? profiler.samples() / (wall_ms / 1000.0) : 0.0;
+            file_ << "," << wall_ms << "," << profiler.samples() << "," << samples_per_sec << "\n";
+            file_.flush();
+        }
+
+    private:
+        std::ofstream file_;
+    };
+
+} // namespace Profiling
+} // namespace ANN
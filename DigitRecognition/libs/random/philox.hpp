@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <thread>
+#include <vector>
+
+namespace ANN {
+namespace Random {
+
+    //
+    // Philox4x32-10 counter based generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+    // Each output block is a pure function of (counter, key), so element i of a stream can be
+    // produced without generating elements 0..i-1. That lets any number of threads fill disjoint
+    // parts of a buffer and still get exactly the numbers a single thread would.
+    //
+    class Philox4x32 {
+    public:
+        using Counter = std::array<uint32_t, 4>;
+        using Key = std::array<uint32_t, 2>;
+
+        static constexpr int ROUNDS = 10;
+
+        static constexpr Counter generate(Counter counter, Key key) {
+            for (int round = 0; round < ROUNDS; ++round) {
+                counter = single_round(counter, key);
+                key[0] += WEYL_0;
+                key[1] += WEYL_1;
+            }
+            return counter;
+        }
+
+    private:
+        static constexpr uint32_t MULTIPLIER_0 = 0xD2511F53;
+        static constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+        static constexpr uint32_t WEYL_0 = 0x9E3779B9;
+        static constexpr uint32_t WEYL_1 = 0xBB67AE85;
+
+        static constexpr Counter single_round(const Counter& counter, const Key& key) {
+            const uint64_t product_0 = static_cast<uint64_t>(MULTIPLIER_0) * counter[0];
+            const uint64_t product_1 = static_cast<uint64_t>(MULTIPLIER_1) * counter[2];
+            return {
+                static_cast<uint32_t>(product_1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<uint32_t>(product_1),
+                static_cast<uint32_t>(product_0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<uint32_t>(product_0)
+            };
+        }
+    };
+
+    //
+    // Random values addressed by (seed, stream, index). The seed picks the experiment, the stream
+    // separates independent consumers (one per layer) and the index is the element position.
+    //
+    class CounterRng {
+    public:
+        CounterRng(uint64_t seed, uint64_t stream)
+            : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}
+            , stream_(stream) {}
+
+        // Uniform in [0, 1)
+        double uniform(uint64_t index) const {
+            auto block = generate(index);
+            return to_unit(block[0], block[1]);
+        }
+
+        // Standard normal, Box-Muller over the two halves of the element's block
+        double normal(uint64_t index) const {
+            auto block = generate(index);
+            const double u1 = 1.0 - to_unit(block[0], block[1]);  // (0, 1], safe for log
+            const double u2 = to_unit(block[2], block[3]);
+            return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * std::numbers::pi * u2);
+        }
+
+    private:
+        Philox4x32::Counter generate(uint64_t index) const {
+            return Philox4x32::generate({static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+                                         static_cast<uint32_t>(stream_), static_cast<uint32_t>(stream_ >> 32)}, key_);
+        }
+
+        // 53 random bits into a double in [0, 1)
+        static double to_unit(uint32_t high, uint32_t low) {
+            const uint64_t bits = (static_cast<uint64_t>(high) << 21) ^ (low >> 11);
+            return static_cast<double>(bits & ((uint64_t(1) << 53) - 1)) * 0x1.0p-53;
+        }
+
+        Philox4x32::Key key_;
+        uint64_t stream_;
+    };
+
+    //
+    // Fill values[i] = generator(i) split over threads (0 = one per hardware thread).
+    // Small buffers are filled on the calling thread, starting threads would cost more.
+    // The result does not depend on the number of threads.
+    //
+    template <typename Generator>
+    void parallel_fill(double* values, size_t count, Generator generator, unsigned int threads = 0) {
+        constexpr size_t MIN_PER_THREAD = 1 << 15;
+
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = static_cast<unsigned int>(std::min<size_t>(threads, std::max<size_t>(1, count / MIN_PER_THREAD)));
+
+        auto fill_range = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                values[i] = generator(i);
+            }
+        };
+
+        if (threads <= 1) {
+            fill_range(0, count);
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        const size_t chunk = (count + threads - 1) / threads;
+        for (unsigned int t = 0; t < threads; ++t) {
+            const size_t begin = std::min(count, t * chunk);
+            const size_t end = std::min(count, begin + chunk);
+            workers.emplace_back(fill_range, begin, end);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+} // namespace Random
+} // namespace ANN
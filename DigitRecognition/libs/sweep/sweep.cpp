@@ -0,0 +1,276 @@
+#include "sweep.hpp"
+#include "../evaluation/evaluation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+namespace ANN {
+
+namespace {
+
+    nlohmann::json read_json_file(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+        nlohmann::json j;
+        file >> j;
+        return j;
+    }
+
+    // "training.learning_rate.initial" -> "/training/learning_rate/initial"
+    nlohmann::json::json_pointer to_pointer(const std::string& dotted_key) {
+        std::string pointer = "/" + dotted_key;
+        std::replace(pointer.begin(), pointer.end(), '.', '/');
+        return nlohmann::json::json_pointer(pointer);
+    }
+
+    // Last component of the dotted key keeps run names short, "initial=0.01"
+    std::string short_key(const std::string& dotted_key) {
+        auto dot = dotted_key.rfind('.');
+        return dot == std::string::npos ? dotted_key : dotted_key.substr(dot + 1);
+    }
+
+    std::string layers_to_string(const std::vector<int>& layers) {
+        std::string result = "[";
+        for (size_t i = 0; i < layers.size(); ++i) {
+            result += std::to_string(layers[i]);
+            if (i < layers.size() - 1) result += ", ";
+        }
+        return result + "]";
+    }
+
+    // CSV field in quotes, embedded quotes doubled
+    std::string csv_quote(const std::string& field) {
+        std::string quoted = "\"";
+        for (char c : field) {
+            quoted += c;
+            if (c == '"') quoted += '"';
+        }
+        return quoted + "\"";
+    }
+
+    // Settings of a run's config that a sweep run does not act on
+    std::vector<std::string> ignored_settings(const Config& config) {
+        std::vector<std::string> ignored;
+        if (config.training.validation_split > 0.0) {
+            ignored.push_back("training.validation_split");
+        }
+        if (config.training.early_stopping.enabled) {
+            ignored.push_back("training.early_stopping");
+        }
+        if (config.training.checkpoint.enabled) {
+            ignored.push_back("training.checkpoint");
+        }
+        return ignored;
+    }
+
+    void train_one(const SweepRun& run, const TrainingSet& training_set, const TrainingSet& test_set, SweepResult& result) {
+        auto start = std::chrono::steady_clock::now();
+        try {
+            const auto& config = run.config;
+            Network network = make_network(config);
+
+            Trainer trainer(network, config.training);
+            std::unique_ptr<Augmenter> augmenter;
+            if (config.training.augmentation.enabled) {
+                augmenter = std::make_unique<Augmenter>(config.training.augmentation, config.data.image_size[0], config.data.image_size[1],
+                                                        config.data.normalize ? 1.0 : 255.0, std::random_device{}());
+                trainer.set_augmenter(augmenter.get());
+            }
+            result.epochs = trainer.run(training_set);
+            network.set_inference_mode(true);
+            network.set_inference_precision(*parse_precision(config.network.inference_precision));
+            // one thread per run, the runs themselves already fill the cores
+            result.test_accuracy = evaluate(network, test_set, 1, config.evaluation.batch_size).accuracy();
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace
+
+Sweep Sweep::from_file(const std::string& sweep_file) {
+    return from_json(read_json_file(sweep_file));
+}
+
+Sweep Sweep::from_json(const nlohmann::json& sweep_json) {
+    Sweep sweep;
+    sweep.threads_ = sweep_json.value("threads", 0u);
+    sweep.output_file_ = sweep_json.value("output", sweep.output_file_);
+
+    // The configs to start from, each listed file or just the base
+    std::vector<std::pair<std::string, nlohmann::json>> bases;
+    if (sweep_json.contains("configs")) {
+        for (const auto& filename : sweep_json["configs"]) {
+            std::string name = filename.get<std::string>();
+            bases.emplace_back(std::filesystem::path(name).stem().string(), read_json_file(name));
+        }
+    } else {
+        std::string name = sweep_json.value("base", "config.json");
+        bases.emplace_back(std::filesystem::path(name).stem().string(), read_json_file(name));
+    }
+
+    // Grid axes, every combination is applied to every base
+    std::vector<std::pair<std::string, std::vector<nlohmann::json>>> axes;
+    if (sweep_json.contains("grid")) {
+        for (const auto& [key, values] : sweep_json["grid"].items()) {
+            if (!values.is_array() || values.empty()) {
+                throw std::runtime_error("Sweep grid entry '" + key + "' must be a non-empty array");
+            }
+            axes.emplace_back(key, std::vector<nlohmann::json>(values.begin(), values.end()));
+        }
+    }
+
+    for (const auto& [base_name, base_json] : bases) {
+        std::vector<size_t> index(axes.size(), 0);
+
+        while (true) {
+            nlohmann::json run_json = base_json;
+            std::string name = base_name;
+
+            for (size_t a = 0; a < axes.size(); ++a) {
+                const auto& value = axes[a].second[index[a]];
+                run_json[to_pointer(axes[a].first)] = value;
+                name += (a == 0 ? "[" : ",") + short_key(axes[a].first) + "="
+                      + (value.is_string() ? value.get<std::string>() : value.dump());
+            }
+            if (!axes.empty()) {
+                name += "]";
+            }
+
+            SweepRun run{name, Config(run_json)};
+            if (!run.config.validate()) {
+                throw std::runtime_error("Invalid configuration in sweep run " + name);
+            }
+            sweep.runs_.push_back(std::move(run));
+
+            // Advance the grid odometer, last axis fastest
+            size_t a = axes.size();
+            while (a > 0 && ++index[a - 1] == axes[a - 1].second.size()) {
+                index[a - 1] = 0;
+                --a;
+            }
+            if (a == 0) {
+                break;
+            }
+        }
+    }
+
+    // The data set is loaded once, so every run has to agree on it
+    for (const auto& run : sweep.runs_) {
+        const auto& first = sweep.runs_.front().config.data;
+        const auto& data = run.config.data;
+        if (data.train_path != first.train_path || data.test_path != first.test_path || data.normalize != first.normalize) {
+            throw std::runtime_error("Sweep run " + run.name + " uses a different data set, all runs must share one");
+        }
+    }
+
+    // Without its teacher a distillation run would quietly be a different experiment
+    std::set<std::string> ignored;
+    for (const auto& run : sweep.runs_) {
+        if (run.config.training.distillation.enabled) {
+            throw std::runtime_error("Sweep run " + run.name + " enables training.distillation, sweep runs do not support it");
+        }
+        for (auto& setting : ignored_settings(run.config)) {
+            ignored.insert(std::move(setting));
+        }
+    }
+    if (!ignored.empty()) {
+        std::cerr << "Warning: sweep runs ignore";
+        for (const auto& setting : ignored) {
+            std::cerr << " " << setting;
+        }
+        std::cerr << ", each run trains on the whole training set for training.epochs epochs" << std::endl;
+    }
+
+    return sweep;
+}
+
+unsigned int Sweep::threads() const {
+    unsigned int threads = threads_ > 0 ? threads_ : std::max(1u, std::thread::hardware_concurrency());
+    return std::min<unsigned int>(threads, static_cast<unsigned int>(std::max<size_t>(1, runs_.size())));
+}
+
+std::vector<SweepResult> Sweep::run(const TrainingSet& training_set, const TrainingSet& test_set) const {
+    // Config's default constructor reads config.json, so build each result from its run
+    std::vector<SweepResult> results;
+    results.reserve(runs_.size());
+    for (const auto& run : runs_) {
+        SweepResult result{run.name, run.config, {}, 0.0, 0.0, {}};
+        results.push_back(std::move(result));
+    }
+
+    std::atomic<size_t> next_run{0};
+    std::mutex output_mutex;
+
+    // Workers pull the next run until none are left, results land in run order
+    auto worker = [&]() {
+        for (size_t i = next_run++; i < runs_.size(); i = next_run++) {
+            train_one(runs_[i], training_set, test_set, results[i]);
+
+            std::lock_guard<std::mutex> lock(output_mutex);
+            if (results[i].error.empty()) {
+                std::cout << "Sweep run " << (i + 1) << "/" << runs_.size() << " " << results[i].name
+                          << " | Test Acc: " << results[i].test_accuracy << "%"
+                          << " | " << results[i].seconds << "s" << std::endl;
+            } else {
+                std::cerr << "Sweep run " << (i + 1) << "/" << runs_.size() << " " << results[i].name
+                          << " failed: " << results[i].error << std::endl;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads(); ++t) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    return results;
+}
+
+bool Sweep::save_csv(const std::vector<SweepResult>& results, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "experiment_name,layers,activation,weight_init,learning_rate,lr_schedule,epochs,"
+         << "final_loss,min_loss,final_train_accuracy,test_accuracy,seconds,error\n";
+
+    for (const auto& result : results) {
+        const auto& config = result.config;
+
+        double final_loss = 0.0, min_loss = 0.0, final_accuracy = 0.0;
+        if (!result.epochs.empty()) {
+            final_loss = result.epochs.back().avg_loss;
+            final_accuracy = result.epochs.back().accuracy;
+            min_loss = std::min_element(result.epochs.begin(), result.epochs.end(),
+                [](const EpochStats& a, const EpochStats& b) { return a.avg_loss < b.avg_loss; })->avg_loss;
+        }
+
+        file << csv_quote(result.name) << "," << csv_quote(layers_to_string(config.network.layers)) << ","
+             << config.network.activation << "," << config.network.weight_init.method << ","
+             << config.training.learning_rate.initial << "," << config.training.learning_rate.schedule << ","
+             << result.epochs.size() << "," << final_loss << "," << min_loss << ","
+             << final_accuracy << "," << result.test_accuracy << "," << result.seconds << ","
+             << csv_quote(result.error) << "\n";
+    }
+    return true;
+}
+
+} // namespace ANN
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "../config/config.hpp"
+#include "../training/training.hpp"
+
+namespace ANN {
+
+    //
+    // One configuration to train as part of a sweep
+    //
+    struct SweepRun {
+        std::string name;
+        Config config;
+    };
+
+    struct SweepResult {
+        std::string name;
+        Config config;
+        std::vector<EpochStats> epochs;
+        double test_accuracy = 0.0;     // percent
+        double seconds = 0.0;           // wall time for training and testing this run
+        std::string error;              // empty unless the run threw
+    };
+
+    //
+    // Hyperparameter sweep, trains several configurations concurrently over one shared data set.
+    //
+    // The sweep file lists config files and/or a grid of overrides applied to a base config:
+    //  {
+    //    "base": "config.json",
+    //    "configs": ["config_small.json", "config_wide.json"],
+    //    "grid": {
+    //      "training.learning_rate.initial": [0.01, 0.005],
+    //      "network.layers": [[784, 128, 10], [784, 256, 64, 10]]
+    //    },
+    //    "threads": 0,
+    //    "output": "DigitRecog_Sweep.csv"
+    //  }
+    // Every listed config (or the base when none are listed) is crossed with every grid point.
+    //
+    class Sweep {
+    public:
+        static Sweep from_file(const std::string& sweep_file);
+        static Sweep from_json(const nlohmann::json& sweep_json);
+
+        const std::vector<SweepRun>& runs() const { return runs_; }
+        const std::string& output_file() const { return output_file_; }
+
+        // Worker threads to use, 0 means one per hardware thread
+        unsigned int threads() const;
+
+        // Train and test every run, the data sets are shared read only between the workers
+        std::vector<SweepResult> run(const TrainingSet& training_set, const TrainingSet& test_set) const;
+
+        // One summary row per run
+        static bool save_csv(const std::vector<SweepResult>& results, const std::string& filename);
+
+    private:
+        std::vector<SweepRun> runs_;
+        unsigned int threads_ = 0;
+        std::string output_file_ = "DigitRecog_Sweep.csv";
+    };
+
+} // namespace ANN
@@ -0,0 +1,194 @@
+#include "../sweep.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+// Small config files the sweeps start from, removed again at the end of main
+const char* base_file = "test_sweep_base.json";
+const char* other_file = "test_sweep_other.json";
+const char* other_data_file = "test_sweep_other_data.json";
+const char* csv_file = "test_sweep_results.csv";
+
+void write_json(const std::string& filename, const nlohmann::json& j) {
+    std::ofstream file(filename);
+    file << j.dump(2);
+}
+
+nlohmann::json base_config() {
+    return {
+        {"network", {{"layers", {16, 8, 4}}, {"activation", "sigmoid"}}},
+        {"training", {{"epochs", 1}, {"learning_rate", {{"initial", 0.5}, {"schedule", "constant"}}}}},
+        {"data", {{"train_path", "train/"}, {"test_path", "test/"}}}
+    };
+}
+
+std::vector<std::string> run_names(const ANN::Sweep& sweep) {
+    std::vector<std::string> names;
+    for (const auto& run : sweep.runs()) {
+        names.push_back(run.name);
+    }
+    return names;
+}
+
+// True if building the sweep throws
+bool rejects(const nlohmann::json& sweep_json) {
+    try {
+        ANN::Sweep::from_json(sweep_json);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+bool test_grid_expansion() {
+    std::cout << "Testing grid expansion order and naming..." << std::endl;
+
+    // Axes are taken in key order, the last one changing fastest
+    auto sweep = ANN::Sweep::from_json({
+        {"base", base_file},
+        {"grid", {
+            {"training.learning_rate.initial", {0.1, 0.05}},
+            {"network.layers", {{16, 8, 4}, {16, 4}}}
+        }}
+    });
+    ASSERT_TRUE((run_names(sweep) == std::vector<std::string>{
+        "test_sweep_base[layers=[16,8,4],initial=0.1]",
+        "test_sweep_base[layers=[16,8,4],initial=0.05]",
+        "test_sweep_base[layers=[16,4],initial=0.1]",
+        "test_sweep_base[layers=[16,4],initial=0.05]"
+    }));
+    const auto& runs = sweep.runs();
+    ASSERT_TRUE((runs[2].config.network.layers == std::vector<int>{16, 4}));
+    ASSERT_TRUE(runs[2].config.training.learning_rate.initial == 0.1);
+    ASSERT_TRUE(runs[1].config.training.learning_rate.initial == 0.05);
+    ASSERT_TRUE(runs[1].config.training.epochs == 1);     // the rest comes from the base
+
+    // Every listed config is crossed with every grid point, strings are named without quotes
+    auto crossed = ANN::Sweep::from_json({
+        {"configs", nlohmann::json::array({base_file, other_file})},
+        {"grid", {{"network.activation", nlohmann::json::array({"sigmoid", "relu"})}}}
+    });
+    ASSERT_TRUE((run_names(crossed) == std::vector<std::string>{
+        "test_sweep_base[activation=sigmoid]",
+        "test_sweep_base[activation=relu]",
+        "test_sweep_other[activation=sigmoid]",
+        "test_sweep_other[activation=relu]"
+    }));
+    ASSERT_TRUE(crossed.runs()[3].config.network.activation == "relu");
+    ASSERT_TRUE((crossed.runs()[3].config.network.layers == std::vector<int>{16, 12, 4}));
+
+    // No grid, one run per config under its file name
+    auto listed = ANN::Sweep::from_json({{"configs", nlohmann::json::array({base_file, other_file})}, {"threads", 8}});
+    ASSERT_TRUE((run_names(listed) == std::vector<std::string>{"test_sweep_base", "test_sweep_other"}));
+    ASSERT_TRUE(listed.threads() == 2);     // never more threads than runs
+
+    std::cout << "✓ Grid expansion tests passed" << std::endl;
+    return true;
+}
+
+bool test_rejections() {
+    std::cout << "Testing invalid sweeps are rejected..." << std::endl;
+
+    ASSERT_TRUE(rejects({{"base", base_file}, {"grid", {{"training.epochs", 3}}}}));
+    ASSERT_TRUE(rejects({{"base", base_file}, {"grid", {{"training.epochs", nlohmann::json::array()}}}}));
+    ASSERT_TRUE(rejects({{"configs", nlohmann::json::array({base_file, other_data_file})}}));
+    ASSERT_TRUE(rejects({{"base", base_file}, {"grid", {{"data.train_path", nlohmann::json::array({"train/", "elsewhere/"})}}}}));
+    ASSERT_TRUE(rejects({{"base", base_file}, {"grid", {{"training.learning_rate.schedule", nlohmann::json::array({"constant", "bogus"})}}}}));
+    nlohmann::json distillation = {{"enabled", true}, {"teacher", "teacher.bin"}};
+    ASSERT_TRUE(rejects({{"base", base_file}, {"grid", {{"training.distillation", nlohmann::json::array({distillation})}}}}));
+    ASSERT_TRUE(rejects({{"base", "test_sweep_missing.json"}}));
+    ASSERT_TRUE(!rejects({{"base", base_file}, {"grid", {{"training.epochs", {1, 2}}}}}));
+
+    std::cout << "✓ Rejection tests passed" << std::endl;
+    return true;
+}
+
+bool test_merged_csv() {
+    std::cout << "Testing the merged CSV..." << std::endl;
+
+    // Each class lights its own quarter of the 16 inputs
+    ANN::TrainingSet data_set;
+    for (int i = 0; i < 32; ++i) {
+        ANN::TrainingInstance instance;
+        instance.label = i % 4;
+        instance.input_data.assign(16, 0.0);
+        for (int p = 0; p < 4; ++p) {
+            instance.input_data[instance.label * 4 + p] = 1.0;
+        }
+        data_set.add_instance(std::move(instance));
+    }
+
+    auto sweep = ANN::Sweep::from_json({
+        {"base", base_file},
+        {"grid", {{"training.epochs", {1, 2}}}},
+        {"threads", 2}
+    });
+    auto results = sweep.run(data_set, data_set);
+    ASSERT_TRUE(results.size() == 2);
+    ASSERT_TRUE(results[0].name == sweep.runs()[0].name && results[1].name == sweep.runs()[1].name);
+    ASSERT_TRUE(results[0].error.empty() && results[0].epochs.size() == 1);
+    ASSERT_TRUE(results[1].error.empty() && results[1].epochs.size() == 2);
+
+    // Quotes in names and errors are doubled so the row keeps its columns
+    results[1].name = "run \"b\"";
+    results[1].error = "could not open \"weights.bin\", giving up";
+    ASSERT_TRUE(ANN::Sweep::save_csv(results, csv_file));
+
+    std::ifstream file(csv_file);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(file, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_TRUE(lines.size() == 3);
+    ASSERT_TRUE(lines[0].starts_with("experiment_name,layers,"));
+    ASSERT_TRUE(lines[1].starts_with("\"test_sweep_base[epochs=1]\",\"[16, 8, 4]\",sigmoid,"));
+    ASSERT_TRUE(lines[1].ends_with(",\"\""));
+    ASSERT_TRUE(lines[2].starts_with("\"run \"\"b\"\"\","));
+    ASSERT_TRUE(lines[2].ends_with(",\"could not open \"\"weights.bin\"\", giving up\""));
+
+    std::cout << "✓ Merged CSV tests passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Sweep Tests" << std::endl;
+    std::cout << "===================" << std::endl;
+
+    write_json(base_file, base_config());
+    auto other = base_config();
+    other["network"]["layers"] = {16, 12, 4};
+    write_json(other_file, other);
+    auto other_data = base_config();
+    other_data["data"]["test_path"] = "other_test/";
+    write_json(other_data_file, other_data);
+
+    bool all_passed = true;
+    all_passed &= test_grid_expansion();
+    all_passed &= test_rejections();
+    all_passed &= test_merged_csv();
+
+    for (const char* filename : {base_file, other_file, other_data_file, csv_file}) {
+        std::remove(filename);
+    }
+
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
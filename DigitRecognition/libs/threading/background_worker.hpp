@@ -0,0 +1,126 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace ANN {
+
+    //
+    // One background thread working through jobs queued from another thread, so that thread
+    // (usually the training thread) only pays for building the job, typically a copy of the
+    // weights taken outside any lock. Jobs are processed one at a time in the order queued.
+    //
+    // How many jobs may wait is up to the owner: push() always queues, push_when_room() blocks
+    // while the queue is full, and take_newest() hands back a job not yet started so a newer
+    // one can replace it. The destructor processes whatever is still queued, so declare the
+    // worker after every member process uses.
+    //
+    template <typename Job>
+    class BackgroundWorker {
+    public:
+        using Process = std::function<void(Job& job)>;
+
+        explicit BackgroundWorker(Process process)
+            : process_(std::move(process))
+        {
+            thread_ = std::thread(&BackgroundWorker::run, this);
+        }
+
+        ~BackgroundWorker() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                shutdown_ = true;
+            }
+            condition_.notify_all();
+            thread_.join();
+        }
+
+        BackgroundWorker(const BackgroundWorker&) = delete;
+        BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+        // Jobs waiting, not counting the one being processed
+        size_t queued() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return queue_.size();
+        }
+
+        void push(Job job) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                queue_.push_back(std::move(job));
+            }
+            condition_.notify_all();
+        }
+
+        // Blocks until fewer than max_queued jobs are waiting
+        void push_when_room(Job job, size_t max_queued) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [&] { return queue_.size() < max_queued; });
+                queue_.push_back(std::move(job));
+            }
+            condition_.notify_all();
+        }
+
+        // Newest job not yet started, removed from the queue, empty if none is waiting
+        std::optional<Job> take_newest() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (queue_.empty()) {
+                return std::nullopt;
+            }
+            std::optional<Job> job(std::move(queue_.back()));
+            queue_.pop_back();
+            return job;
+        }
+
+        // Block until every queued job has been processed
+        void wait() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return queue_.empty() && !busy_; });
+        }
+
+    private:
+        void run() {
+            for (;;) {
+                std::optional<Job> job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    condition_.wait(lock, [this] { return !queue_.empty() || shutdown_; });
+                    if (queue_.empty()) {
+                        return;
+                    }
+                    job.emplace(std::move(queue_.front()));
+                    queue_.pop_front();
+                    busy_ = true;
+                }
+                condition_.notify_all();    // room for push_when_room()
+
+                process_(*job);
+                job.reset();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    busy_ = false;
+                }
+                condition_.notify_all();
+            }
+        }
+
+        Process process_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable condition_;
+        std::deque<Job> queue_;
+        bool busy_ = false;
+        bool shutdown_ = false;
+
+        std::thread thread_;
+    };
+
+} // namespace ANN
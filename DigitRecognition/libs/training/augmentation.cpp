@@ -0,0 +1,282 @@
+#include "augmentation.hpp"
+#include "training.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace ANN {
+
+namespace {
+
+    // Uniform in [-1, 1)
+    double symmetric(const Random::CounterRng& rng, uint64_t index) {
+        return 2.0 * rng.uniform(index) - 1.0;
+    }
+
+} // namespace
+
+Augmenter::Augmenter(const Settings& settings, int width, int height, double max_value, uint64_t seed)
+    : settings_(settings)
+    , width_(width)
+    , height_(height)
+    , max_value_(max_value)
+    , seed_(seed)
+{
+    // Normalised gaussian, 3 sigma either side
+    if (settings_.elastic_alpha > 0.0) {
+        const int radius = static_cast<int>(std::ceil(3.0 * settings_.elastic_sigma));
+        kernel_.resize(2 * radius + 1);
+        double sum = 0.0;
+        for (int k = -radius; k <= radius; ++k) {
+            double weight = std::exp(-0.5 * k * k / (settings_.elastic_sigma * settings_.elastic_sigma));
+            kernel_[k + radius] = weight;
+            sum += weight;
+        }
+        for (double& weight : kernel_) {
+            weight /= sum;
+        }
+    }
+}
+
+void Augmenter::apply(const std::vector<double>& image, std::vector<double>& output,
+                      uint64_t epoch, uint64_t sample, AugmentWorkspace& workspace) const {
+    const size_t pixels = static_cast<size_t>(width_) * height_;
+    if (image.size() != pixels) {
+        output = image;
+        return;
+    }
+    output.resize(pixels);
+
+    // Every draw of a sample sits at its own offset in the epoch's stream:
+    // 4 transform parameters, two displacement fields, then the noise
+    const Random::CounterRng rng(seed_, epoch);
+    const uint64_t base = sample * (4 + 3 * pixels);
+
+    const double angle = symmetric(rng, base) * settings_.rotation * std::numbers::pi / 180.0;
+    const double scale = 1.0 + symmetric(rng, base + 1) * settings_.scale;
+    const double shift_x = symmetric(rng, base + 2) * settings_.shift;
+    const double shift_y = symmetric(rng, base + 3) * settings_.shift;
+
+    const bool elastic = settings_.elastic_alpha > 0.0;
+    if (elastic) {
+        elastic_field(rng, base + 4, workspace);
+    }
+
+    // Inverse mapping, each output pixel looks up where it came from in the source
+    const double cos_a = std::cos(angle) / scale;
+    const double sin_a = std::sin(angle) / scale;
+    const double centre_x = (width_ - 1) / 2.0;
+    const double centre_y = (height_ - 1) / 2.0;
+
+    workspace.source_x.resize(width_);
+    workspace.source_y.resize(width_);
+    double* source_x = workspace.source_x.data();
+    double* source_y = workspace.source_y.data();
+
+    auto pixel = [&](int x, int y) {
+        return (x >= 0 && x < width_ && y >= 0 && y < height_) ? image[static_cast<size_t>(y) * width_ + x] : 0.0;
+    };
+
+    for (int y = 0; y < height_; ++y) {
+        const double offset_y = y - centre_y - shift_y;
+        const size_t row = static_cast<size_t>(y) * width_;
+
+        for (int x = 0; x < width_; ++x) {
+            const double offset_x = x - centre_x - shift_x;
+            source_x[x] = cos_a * offset_x + sin_a * offset_y + centre_x;
+            source_y[x] = -sin_a * offset_x + cos_a * offset_y + centre_y;
+        }
+        if (elastic) {
+            const double* dx = workspace.dx.data() + row;
+            const double* dy = workspace.dy.data() + row;
+            for (int x = 0; x < width_; ++x) {
+                source_x[x] += dx[x];
+                source_y[x] += dy[x];
+            }
+        }
+
+        // Bilinear, zero outside the image
+        for (int x = 0; x < width_; ++x) {
+            const double floor_x = std::floor(source_x[x]);
+            const double floor_y = std::floor(source_y[x]);
+            const double fraction_x = source_x[x] - floor_x;
+            const double fraction_y = source_y[x] - floor_y;
+            const int x0 = static_cast<int>(floor_x);
+            const int y0 = static_cast<int>(floor_y);
+
+            const double top = pixel(x0, y0) * (1.0 - fraction_x) + pixel(x0 + 1, y0) * fraction_x;
+            const double bottom = pixel(x0, y0 + 1) * (1.0 - fraction_x) + pixel(x0 + 1, y0 + 1) * fraction_x;
+            output[row + x] = top * (1.0 - fraction_y) + bottom * fraction_y;
+        }
+    }
+
+    if (settings_.noise > 0.0) {
+        const uint64_t noise_base = base + 4 + 2 * pixels;
+        for (size_t p = 0; p < pixels; ++p) {
+            output[p] = std::clamp(output[p] + settings_.noise * max_value_ * rng.normal(noise_base + p), 0.0, max_value_);
+        }
+    }
+}
+
+void Augmenter::elastic_field(const Random::CounterRng& rng, uint64_t base, AugmentWorkspace& workspace) const {
+    const size_t pixels = static_cast<size_t>(width_) * height_;
+    workspace.dx.resize(pixels);
+    workspace.dy.resize(pixels);
+
+    // Uniform displacements smoothed into a field, then scaled to alpha
+    for (size_t p = 0; p < pixels; ++p) {
+        workspace.dx[p] = symmetric(rng, base + p);
+        workspace.dy[p] = symmetric(rng, base + pixels + p);
+    }
+    blur(workspace.dx, workspace);
+    blur(workspace.dy, workspace);
+
+    for (size_t p = 0; p < pixels; ++p) {
+        workspace.dx[p] *= settings_.elastic_alpha;
+        workspace.dy[p] *= settings_.elastic_alpha;
+    }
+}
+
+void Augmenter::blur(std::vector<double>& field, AugmentWorkspace& workspace) const {
+    const int radius = static_cast<int>(kernel_.size() / 2);
+    const size_t width = width_;
+    workspace.blurred.assign(field.size(), 0.0);
+    workspace.padded_row.resize(width + 2 * radius);
+
+    // Along the rows, each row padded with its edge values so the inner loop has no bounds checks
+    for (int y = 0; y < height_; ++y) {
+        const double* row = field.data() + y * width;
+        double* padded = workspace.padded_row.data();
+        std::fill(padded, padded + radius, row[0]);
+        std::copy(row, row + width, padded + radius);
+        std::fill(padded + radius + width, padded + 2 * radius + width, row[width - 1]);
+
+        double* target = workspace.blurred.data() + y * width;
+        for (size_t k = 0; k < kernel_.size(); ++k) {
+            const double weight = kernel_[k];
+            const double* source = padded + k;
+            for (size_t x = 0; x < width; ++x) {
+                target[x] += weight * source[x];
+            }
+        }
+    }
+
+    // Down the columns, a whole row at a time, edge rows repeated
+    std::fill(field.begin(), field.end(), 0.0);
+    for (int y = 0; y < height_; ++y) {
+        double* target = field.data() + y * width;
+        for (int k = -radius; k <= radius; ++k) {
+            const double weight = kernel_[k + radius];
+            const double* source = workspace.blurred.data() + std::clamp(y + k, 0, height_ - 1) * width;
+            for (size_t x = 0; x < width; ++x) {
+                target[x] += weight * source[x];
+            }
+        }
+    }
+}
+
+AugmentationPipeline::AugmentationPipeline(const TrainingSet& training_set, const std::vector<size_t>& order,
+                                           const Augmenter& augmenter, int epoch, size_t first)
+    : training_set_(training_set)
+    , order_(order)
+    , augmenter_(augmenter)
+    , epoch_(epoch)
+    , first_(std::min(first, order.size()))
+    , batch_size_(static_cast<size_t>(std::max(1, augmenter.settings().batch_size)))
+    , batch_count_((order.size() - first_ + batch_size_ - 1) / batch_size_)
+    , slots_(static_cast<size_t>(std::max(1, augmenter.settings().queue_batches)))
+{
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        slots_[i].batch_index = i;
+    }
+
+    size_t threads = augmenter.settings().threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, batch_count_);
+    for (size_t t = 0; t < threads; ++t) {
+        workers_.emplace_back(&AugmentationPipeline::run, this);
+    }
+}
+
+AugmentationPipeline::~AugmentationPipeline() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    condition_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+const AugmentedBatch* AugmentationPipeline::next() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // Hand the previous batch's slot back for the batch queue_batches further on
+    if (holding_) {
+        Slot& previous = slots_[(next_to_consume_ - 1) % slots_.size()];
+        previous.ready = false;
+        previous.batch_index += slots_.size();
+        holding_ = false;
+        condition_.notify_all();
+    }
+
+    if (next_to_consume_ >= batch_count_) {
+        return nullptr;
+    }
+
+    Slot& slot = slots_[next_to_consume_ % slots_.size()];
+    condition_.wait(lock, [&] { return slot.ready && slot.batch_index == next_to_consume_; });
+    next_to_consume_++;
+    holding_ = true;
+    return &slot.batch;
+}
+
+void AugmentationPipeline::run() {
+    const auto& instances = training_set_.get_instances();
+    AugmentWorkspace workspace;
+
+    for (;;) {
+        size_t batch_index;
+        Slot* slot;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (shutdown_ || next_to_fill_ >= batch_count_) {
+                return;
+            }
+            batch_index = next_to_fill_++;
+            slot = &slots_[batch_index % slots_.size()];
+
+            // Wait for the consumer to be done with the batch one queue length back
+            condition_.wait(lock, [&] { return shutdown_ || (slot->batch_index == batch_index && !slot->ready); });
+            if (shutdown_) {
+                return;
+            }
+        }
+
+        // The slot is this thread's alone until it is marked ready
+        const size_t start = first_ + batch_index * batch_size_;
+        const size_t count = std::min(batch_size_, order_.size() - start);
+        AugmentedBatch& batch = slot->batch;
+        batch.inputs.resize(count);
+        batch.labels.resize(count);
+        batch.indices.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            const size_t index = order_[start + i];
+            augmenter_.apply(instances[index].input_data, batch.inputs[i], epoch_, index, workspace);
+            batch.labels[i] = instances[index].label;
+            batch.indices[i] = index;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slot->ready = true;
+        }
+        condition_.notify_all();
+    }
+}
+
+} // namespace ANN
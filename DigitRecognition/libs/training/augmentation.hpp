@@ -0,0 +1,119 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../config/config.hpp"
+#include "../random/philox.hpp"
+
+namespace ANN {
+
+    class TrainingSet;
+
+    //
+    // Scratch buffers for Augmenter::apply, one per augmentation thread
+    //
+    struct AugmentWorkspace {
+        std::vector<double> dx;         // elastic displacement field
+        std::vector<double> dy;
+        std::vector<double> blurred;
+        std::vector<double> padded_row;
+        std::vector<double> source_x;   // sample positions of one output row
+        std::vector<double> source_y;
+    };
+
+    //
+    // Random affine transform (rotation, scale, shift), elastic distortion (Simard et al. 2003)
+    // and gaussian noise applied to a width x height image, sampled bilinearly with zero outside.
+    // The draw is a pure function of (seed, epoch, sample), so any thread can augment any sample
+    // and a run is repeatable. The loops work a row at a time on contiguous arrays so the compiler
+    // can vectorise them.
+    //
+    class Augmenter {
+    public:
+        using Settings = Config::TrainingConfig::AugmentationConfig;
+
+        // max_value clamps the result, 1 for normalised images, 255 otherwise
+        Augmenter(const Settings& settings, int width, int height, double max_value = 1.0, uint64_t seed = 0);
+
+        // Write the augmented image to output, resized as needed.
+        // Images that are not width x height are copied unchanged.
+        void apply(const std::vector<double>& image, std::vector<double>& output,
+                   uint64_t epoch, uint64_t sample, AugmentWorkspace& workspace) const;
+
+        const Settings& settings() const { return settings_; }
+        int width() const { return width_; }
+        int height() const { return height_; }
+        uint64_t seed() const { return seed_; }
+
+    private:
+        void elastic_field(const Random::CounterRng& rng, uint64_t base, AugmentWorkspace& workspace) const;
+        void blur(std::vector<double>& field, AugmentWorkspace& workspace) const;
+
+        Settings settings_;
+        int width_;
+        int height_;
+        double max_value_;
+        uint64_t seed_;
+        std::vector<double> kernel_;    // elastic smoothing gaussian
+    };
+
+    //
+    // One run of augmented samples, in training order
+    //
+    struct AugmentedBatch {
+        std::vector<std::vector<double>> inputs;
+        std::vector<int> labels;
+        std::vector<size_t> indices;    // of the source images in the training set
+    };
+
+    //
+    // Augments one epoch of a training set on worker threads, a batch at a time, while the
+    // training thread consumes earlier batches. At most queue_batches batches are held, the
+    // augmented images never exist for the whole set at once. Starts at order[first], for an
+    // epoch resumed part way through.
+    //
+    class AugmentationPipeline {
+    public:
+        AugmentationPipeline(const TrainingSet& training_set, const std::vector<size_t>& order,
+                             const Augmenter& augmenter, int epoch, size_t first = 0);
+        ~AugmentationPipeline();
+
+        AugmentationPipeline(const AugmentationPipeline&) = delete;
+        AugmentationPipeline& operator=(const AugmentationPipeline&) = delete;
+
+        // Next batch in order, nullptr once the epoch is done. Valid until the next call.
+        const AugmentedBatch* next();
+
+    private:
+        struct Slot {
+            AugmentedBatch batch;
+            size_t batch_index;     // the batch this slot holds or is waiting for
+            bool ready = false;
+        };
+
+        void run();
+
+        const TrainingSet& training_set_;
+        const std::vector<size_t>& order_;
+        const Augmenter& augmenter_;
+        int epoch_;
+        size_t first_;
+        size_t batch_size_;
+        size_t batch_count_;
+
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::vector<Slot> slots_;
+        size_t next_to_fill_ = 0;
+        size_t next_to_consume_ = 0;
+        bool holding_ = false;      // the consumer still has the previous batch
+        bool shutdown_ = false;
+
+        std::vector<std::thread> workers_;
+    };
+
+} // namespace ANN
@@ -0,0 +1,447 @@
+#include "checkpoint.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ANN {
+
+namespace {
+
+    constexpr char CHECKPOINT_MAGIC[4] = {'A', 'N', 'N', 'C'};
+    constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+    std::filesystem::path checkpoint_path(const std::filesystem::path& directory, uint64_t sequence) {
+        std::string number = std::to_string(sequence);
+        number.insert(0, number.size() < 8 ? 8 - number.size() : 0, '0');
+        return directory / ("checkpoint_" + number + ".ckpt");
+    }
+
+    // Sequence number of a checkpoint_N.ckpt file name, 0 for anything else
+    uint64_t checkpoint_sequence(const std::filesystem::path& path) {
+        const std::string name = path.filename().string();
+        const std::string prefix = "checkpoint_";
+        const std::string suffix = ".ckpt";
+        if (name.size() <= prefix.size() + suffix.size() || !name.starts_with(prefix) || !name.ends_with(suffix)) {
+            return 0;
+        }
+        const std::string digits = name.substr(prefix.size(), name.size() - prefix.size() - suffix.size());
+        if (!std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; }) || digits.size() > 18) {
+            return 0;
+        }
+        return std::stoull(digits);
+    }
+
+    // Checkpoints in directory, newest first
+    std::vector<std::pair<uint64_t, std::filesystem::path>> list_checkpoints(const std::filesystem::path& directory) {
+        std::vector<std::pair<uint64_t, std::filesystem::path>> checkpoints;
+        std::error_code error;
+        if (!std::filesystem::is_directory(directory, error)) {
+            return checkpoints;
+        }
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            if (uint64_t sequence = checkpoint_sequence(entry.path()); sequence > 0 && entry.is_regular_file()) {
+                checkpoints.emplace_back(sequence, entry.path());
+            }
+        }
+        std::sort(checkpoints.begin(), checkpoints.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+        return checkpoints;
+    }
+
+    // Push a file's data, or on POSIX a directory's entries, out to the disk. False on failure.
+    bool sync_to_disk(const std::filesystem::path& path) {
+#ifdef _WIN32
+        // Directories cannot be opened like this, NTFS journals the rename itself
+        if (std::filesystem::is_directory(path)) {
+            return true;
+        }
+        const int fd = _wopen(path.c_str(), _O_RDWR | _O_BINARY);
+        if (fd < 0) {
+            return false;
+        }
+        const bool synced = _commit(fd) == 0;
+        _close(fd);
+        return synced;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        const bool synced = ::fsync(fd) == 0;
+        ::close(fd);
+        return synced;
+#endif
+    }
+
+    // FNV-1a over the parameters' bytes
+    uint64_t parameter_checksum(const std::vector<double>& parameters) {
+        uint64_t hash = 14695981039346656037ull;
+        const auto* bytes = reinterpret_cast<const unsigned char*>(parameters.data());
+        for (size_t i = 0; i < parameters.size() * sizeof(double); ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Nibble per value with the count of significant low bytes of its XOR with the base,
+    // two to a byte, followed by those bytes value after value
+    void encode_delta(const std::vector<double>& parameters, const std::vector<double>& base, std::vector<unsigned char>& out) {
+        const size_t count = parameters.size();
+        out.assign((count + 1) / 2, 0);
+        out.reserve(out.size() + count * sizeof(double));
+
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t difference = std::bit_cast<uint64_t>(parameters[i]) ^ std::bit_cast<uint64_t>(base[i]);
+            const unsigned bytes = static_cast<unsigned>((64 - std::countl_zero(difference) + 7) / 8);
+            out[i / 2] |= static_cast<unsigned char>(bytes << (i % 2 ? 4 : 0));
+            for (unsigned b = 0; b < bytes; ++b) {
+                out.push_back(static_cast<unsigned char>(difference >> (8 * b)));
+            }
+        }
+    }
+
+    // parameters holds the base on entry and the decoded checkpoint on return
+    bool decode_delta(const std::vector<unsigned char>& in, std::vector<double>& parameters) {
+        const size_t count = parameters.size();
+        size_t at = (count + 1) / 2;
+        if (in.size() < at) {
+            return false;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const unsigned bytes = (in[i / 2] >> (i % 2 ? 4 : 0)) & 0x0f;
+            if (bytes > 8 || at + bytes > in.size()) {
+                return false;
+            }
+            uint64_t difference = 0;
+            for (unsigned b = 0; b < bytes; ++b) {
+                difference |= static_cast<uint64_t>(in[at++]) << (8 * b);
+            }
+            parameters[i] = std::bit_cast<double>(std::bit_cast<uint64_t>(parameters[i]) ^ difference);
+        }
+        return at == in.size();
+    }
+
+    template <typename T>
+    void write_value(std::ostream& file, T value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    T read_value(std::istream& file) {
+        T value{};
+        file.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    }
+
+    void write_state(std::ostream& file, const TrainingState& state) {
+        write_value<int32_t>(file, state.epoch);
+        write_value<uint64_t>(file, state.position);
+        write_value<double>(file, state.learning_rate);
+        write_value<double>(file, state.total_loss);
+        write_value<int32_t>(file, state.correct);
+        write_value<uint64_t>(file, state.augment_seed);
+        write_value<uint32_t>(file, static_cast<uint32_t>(state.rng.size()));
+        file.write(state.rng.data(), state.rng.size());
+        const std::vector<uint32_t> order(state.order.begin(), state.order.end());
+        write_value<uint64_t>(file, order.size());
+        file.write(reinterpret_cast<const char*>(order.data()), order.size() * sizeof(uint32_t));
+    }
+
+    TrainingState read_state(std::istream& file, const std::string& filename) {
+        TrainingState state;
+        state.epoch = read_value<int32_t>(file);
+        state.position = read_value<uint64_t>(file);
+        state.learning_rate = read_value<double>(file);
+        state.total_loss = read_value<double>(file);
+        state.correct = read_value<int32_t>(file);
+        state.augment_seed = read_value<uint64_t>(file);
+
+        const uint32_t rng_size = read_value<uint32_t>(file);
+        if (!file || rng_size > (1u << 20)) {
+            throw std::runtime_error("Corrupt training state in checkpoint: " + filename);
+        }
+        state.rng.resize(rng_size);
+        file.read(state.rng.data(), rng_size);
+
+        const uint64_t order_size = read_value<uint64_t>(file);
+        if (!file || order_size > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Corrupt training state in checkpoint: " + filename);
+        }
+        std::vector<uint32_t> order(order_size);
+        file.read(reinterpret_cast<char*>(order.data()), order.size() * sizeof(uint32_t));
+        state.order.assign(order.begin(), order.end());
+        if (!file) {
+            throw std::runtime_error("Corrupt training state in checkpoint: " + filename);
+        }
+        return state;
+    }
+
+}
+
+Checkpoint read_checkpoint(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open checkpoint: " + filename);
+    }
+
+    char magic[4] = {};
+    file.read(magic, sizeof(magic));
+    if (!file || std::string(magic, 4) != std::string(CHECKPOINT_MAGIC, 4)) {
+        throw std::runtime_error("Not a checkpoint file: " + filename);
+    }
+    if (uint32_t version = read_value<uint32_t>(file); version != CHECKPOINT_VERSION) {
+        throw std::runtime_error("Unsupported checkpoint version " + std::to_string(version) + ": " + filename);
+    }
+
+    Checkpoint checkpoint;
+    checkpoint.sequence = read_value<uint64_t>(file);
+    const uint64_t base_sequence = read_value<uint64_t>(file);
+    if (!file || (base_sequence != 0 && base_sequence >= checkpoint.sequence)) {
+        throw std::runtime_error("Corrupt checkpoint header: " + filename);
+    }
+    checkpoint.header = Network::read_weights_header(file, filename);
+    checkpoint.state = read_state(file, filename);
+
+    const uint64_t count = read_value<uint64_t>(file);
+    const uint64_t checksum = read_value<uint64_t>(file);
+    if (!file || count > (uint64_t(1) << 40) / sizeof(double)) {
+        throw std::runtime_error("Corrupt checkpoint header: " + filename);
+    }
+
+    if (base_sequence == 0) {
+        checkpoint.parameters.resize(count);
+        file.read(reinterpret_cast<char*>(checkpoint.parameters.data()), count * sizeof(double));
+        if (!file) {
+            throw std::runtime_error("Truncated checkpoint: " + filename);
+        }
+    } else {
+        const uint64_t size = read_value<uint64_t>(file);
+        if (!file || size > count * (sizeof(double) + 1)) {
+            throw std::runtime_error("Corrupt checkpoint header: " + filename);
+        }
+        std::vector<unsigned char> delta(size);
+        file.read(reinterpret_cast<char*>(delta.data()), size);
+        if (!file) {
+            throw std::runtime_error("Truncated checkpoint: " + filename);
+        }
+
+        const auto base_file = checkpoint_path(std::filesystem::path(filename).parent_path(), base_sequence);
+        Checkpoint base = read_checkpoint(base_file.string());
+        if (base.parameters.size() != count || base.header.layer_sizes != checkpoint.header.layer_sizes) {
+            throw std::runtime_error("Checkpoint " + filename + " does not match its base " + base_file.string());
+        }
+        checkpoint.parameters = std::move(base.parameters);
+        if (!decode_delta(delta, checkpoint.parameters)) {
+            throw std::runtime_error("Corrupt checkpoint delta: " + filename);
+        }
+    }
+
+    if (parameter_checksum(checkpoint.parameters) != checksum) {
+        throw std::runtime_error("Checkpoint checksum mismatch: " + filename);
+    }
+    return checkpoint;
+}
+
+std::optional<Checkpoint> load_latest_checkpoint(const std::string& directory) {
+    for (const auto& [sequence, path] : list_checkpoints(directory)) {
+        try {
+            return read_checkpoint(path.string());
+        } catch (const std::exception& e) {
+            // Fall back to an earlier one
+            std::cerr << "Skipping checkpoint: " << e.what() << std::endl;
+        }
+    }
+    return std::nullopt;
+}
+
+void restore_checkpoint(const Checkpoint& checkpoint, Network& network) {
+    if (checkpoint.header.layer_sizes != network.layer_sizes() || checkpoint.header.activation != network.activation()) {
+        throw std::runtime_error("Checkpoint " + std::to_string(checkpoint.sequence) + " is for a different network");
+    }
+    auto parameters = network.parameters();
+    if (parameters.size() != checkpoint.parameters.size()) {
+        throw std::runtime_error("Checkpoint " + std::to_string(checkpoint.sequence) + " has " +
+                                 std::to_string(checkpoint.parameters.size()) + " parameters, the network " +
+                                 std::to_string(parameters.size()));
+    }
+    std::copy(checkpoint.parameters.begin(), checkpoint.parameters.end(), parameters.begin());
+}
+
+AsyncCheckpointWriter::AsyncCheckpointWriter(const Settings& settings)
+    : settings_(settings)
+    , worker_([this](Snapshot& snapshot) {
+        write(snapshot);
+        // Hand the parameter buffer back for the next submit()
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (spare_.capacity() == 0) {
+            spare_ = std::move(snapshot.parameters);
+        }
+    })
+{
+    std::filesystem::create_directories(settings_.directory);
+
+    // Left behind by a run killed while writing, never renamed into place
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(settings_.directory)) {
+        if (entry.path().extension() == ".tmp" && checkpoint_sequence(entry.path().stem()) > 0) {
+            std::filesystem::remove(entry.path(), error);
+        }
+    }
+
+    if (auto existing = list_checkpoints(settings_.directory); !existing.empty()) {
+        next_sequence_ = existing.front().first + 1;
+    }
+}
+
+AsyncCheckpointWriter::~AsyncCheckpointWriter() = default;
+
+bool AsyncCheckpointWriter::submit(const Network& network, const TrainingState& state) {
+    // Take the buffer of a snapshot still waiting, which this one replaces, or a spare one
+    Snapshot snapshot;
+    auto waiting = worker_.take_newest();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (waiting) {
+            snapshot.parameters = std::move(waiting->parameters);
+            superseded_++;
+        } else {
+            snapshot.parameters = std::move(spare_);
+        }
+    }
+
+    const auto parameters = network.parameters();
+    snapshot.parameters.assign(parameters.begin(), parameters.end());
+    snapshot.header = {network.activation(), network.layer_sizes()};
+    snapshot.state = state;
+
+    worker_.push(std::move(snapshot));
+    return !waiting;
+}
+
+void AsyncCheckpointWriter::wait() {
+    worker_.wait();
+}
+
+size_t AsyncCheckpointWriter::written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+size_t AsyncCheckpointWriter::superseded() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return superseded_;
+}
+
+size_t AsyncCheckpointWriter::failed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+uint64_t AsyncCheckpointWriter::bytes_written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_written_;
+}
+
+std::string AsyncCheckpointWriter::last_file() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_file_;
+}
+
+void AsyncCheckpointWriter::write(Snapshot& snapshot) {
+    const std::filesystem::path directory(settings_.directory);
+    const uint64_t sequence = next_sequence_++;
+    const bool delta = settings_.delta && previous_sequence_ != 0 && since_full_ < settings_.full_interval
+                       && previous_.size() == snapshot.parameters.size();
+    const auto path = checkpoint_path(directory, sequence);
+    auto temporary = path;
+    temporary += ".tmp";
+
+    auto fail = [&](const char* what) {
+        std::error_code error;
+        std::filesystem::remove(temporary, error);
+        std::cerr << "Failed to " << what << " checkpoint: " << path.string() << std::endl;
+        std::lock_guard<std::mutex> lock(mutex_);
+        failed_++;
+    };
+
+    uint64_t size = 0;
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        write_value<uint32_t>(file, CHECKPOINT_VERSION);
+        write_value<uint64_t>(file, sequence);
+        write_value<uint64_t>(file, delta ? previous_sequence_ : 0);
+        Network::write_weights_header(file, snapshot.header);
+        write_state(file, snapshot.state);
+        write_value<uint64_t>(file, snapshot.parameters.size());
+        write_value<uint64_t>(file, parameter_checksum(snapshot.parameters));
+
+        if (delta) {
+            std::vector<unsigned char> encoded;
+            encode_delta(snapshot.parameters, previous_, encoded);
+            write_value<uint64_t>(file, encoded.size());
+            file.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+        } else {
+            file.write(reinterpret_cast<const char*>(snapshot.parameters.data()), snapshot.parameters.size() * sizeof(double));
+        }
+        size = static_cast<uint64_t>(file.tellp());
+        file.close();
+
+        if (!file) {
+            fail("write");
+            return;
+        }
+    }
+
+    // On disk before it gets its real name, or a crash could leave an empty file under it
+    if (!sync_to_disk(temporary)) {
+        fail("sync");
+        return;
+    }
+
+    // The rename replaces nothing and is atomic, readers see the whole file or none of it
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        fail("rename");
+        return;
+    }
+
+    // Older files are only removed once the new name itself is on disk
+    const bool durable = sync_to_disk(directory);
+    if (!durable) {
+        std::cerr << "Could not sync checkpoint directory, keeping older checkpoints: " << directory.string() << std::endl;
+    }
+
+    since_full_ = delta ? since_full_ + 1 : 1;
+    previous_sequence_ = sequence;
+    std::swap(previous_, snapshot.parameters);
+
+    // A full checkpoint needs nothing before it
+    if (!delta && durable) {
+        for (const auto& [older, older_path] : list_checkpoints(directory)) {
+            if (older < sequence) {
+                std::filesystem::remove(older_path, error);
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    written_++;
+    bytes_written_ += size;
+    last_file_ = path.string();
+}
+
+} // namespace ANN
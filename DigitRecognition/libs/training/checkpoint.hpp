@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../config/config.hpp"
+#include "../networks/networks.hpp"
+#include "../threading/background_worker.hpp"
+#include "training.hpp"
+
+namespace ANN {
+
+    //
+    // A training checkpoint as read back: the network's shape and parameters and the trainer's state
+    //
+    struct Checkpoint {
+        uint64_t sequence = 0;          // number in the file name, counts up from 1
+        WeightsFileHeader header;
+        std::vector<double> parameters; // Network::parameters() layout
+        TrainingState state;
+    };
+
+    //
+    // Checkpoint file: magic, format version, sequence and base sequence, the weights file header,
+    // the training state, then the parameters either in full or, when base is not 0, as the
+    // bitwise XOR with the base checkpoint's. Small SGD steps leave sign, exponent and high
+    // mantissa alone, so each XOR is stored as a 4 bit byte count plus only its low non-zero
+    // bytes, and weights that never moved (e.g. for always blank pixels) cost half a byte.
+    // A checksum of the parameters catches a delta read against the wrong base.
+    //
+    // Reads filename, and the chain of checkpoints it builds on from the same directory.
+    // Throws if any of them is missing, corrupt or does not match.
+    Checkpoint read_checkpoint(const std::string& filename);
+
+    // Latest checkpoint in directory that reads back, empty if there is none
+    std::optional<Checkpoint> load_latest_checkpoint(const std::string& directory);
+
+    // Copy the checkpoint's parameters into network, throws if its layers or activation differ
+    void restore_checkpoint(const Checkpoint& checkpoint, Network& network);
+
+    //
+    // Writes checkpoints from a background thread so training only pays for one copy of the
+    // parameter block. Every file is written under a temporary name, synced and renamed into
+    // place, so a crash part way through a write leaves the previous checkpoint intact.
+    // With delta encoding, checkpoints between full ones store the change since the previous
+    // checkpoint; once a full one and its directory entry are on disk the older files are removed.
+    // At most one snapshot waits behind the one being written, a newer submit() replaces it.
+    //
+    class AsyncCheckpointWriter {
+    public:
+        using Settings = Config::TrainingConfig::CheckpointConfig;
+
+        // Creates settings.directory, numbering carries on after any checkpoints already in it
+        explicit AsyncCheckpointWriter(const Settings& settings);
+        ~AsyncCheckpointWriter();  // writes whatever is still queued
+
+        AsyncCheckpointWriter(const AsyncCheckpointWriter&) = delete;
+        AsyncCheckpointWriter& operator=(const AsyncCheckpointWriter&) = delete;
+
+        // Queue the network's parameters as they are now with the state to resume from, called
+        // from the training thread. Returns false if this replaced a snapshot not yet written.
+        bool submit(const Network& network, const TrainingState& state);
+
+        // Block until every queued checkpoint has been written
+        void wait();
+
+        size_t written() const;
+        size_t superseded() const;
+        size_t failed() const;
+        uint64_t bytes_written() const;
+        std::string last_file() const;  // empty until one has been written
+
+    private:
+        struct Snapshot {
+            WeightsFileHeader header;
+            std::vector<double> parameters;
+            TrainingState state;
+        };
+
+        void write(Snapshot& snapshot);
+
+        Settings settings_;
+
+        mutable std::mutex mutex_;      // guards spare_, the counters and last_file_
+        std::vector<double> spare_;     // parameter buffer handed back by the writer, reused by submit()
+        size_t written_ = 0;
+        size_t superseded_ = 0;
+        size_t failed_ = 0;
+        uint64_t bytes_written_ = 0;
+        std::string last_file_;
+
+        // Writer thread only
+        uint64_t next_sequence_ = 1;
+        uint64_t previous_sequence_ = 0;    // 0 = nothing to take a delta against
+        std::vector<double> previous_;
+        int since_full_ = 0;
+
+        BackgroundWorker<Snapshot> worker_;
+    };
+
+} // namespace ANN
@@ -0,0 +1,68 @@
+#include "distillation.hpp"
+#include "training.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace ANN {
+
+TeacherCache::TeacherCache(const Network& teacher, const TrainingSet& training_set, unsigned int threads)
+    : outputs_(teacher.output_size())
+{
+    const auto& instances = training_set.get_instances();
+    logits_.resize(instances.size() * outputs_);
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned int>(std::min<size_t>(threads, std::max<size_t>(1, instances.size())));
+
+    // Every thread runs its own copy of the teacher, forward passes write into the layers
+    auto worker = [&](size_t first) {
+        Network network(teacher);
+        for (size_t i = first; i < instances.size(); i += threads) {
+            auto logits = network.predict_logits(instances[i].input_data);
+            std::copy(logits.begin(), logits.end(), logits_.begin() + i * outputs_);
+        }
+    };
+
+    if (threads == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; ++t) {
+            workers.emplace_back(worker, t);
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+}
+
+void TeacherCache::soft_targets(size_t index, double temperature, double* targets) const {
+    const double* values = logits(index);
+
+    // Shift by the largest logit so exp cannot overflow
+    const double largest = *std::max_element(values, values + outputs_);
+    double sum = 0.0;
+    for (size_t i = 0; i < outputs_; ++i) {
+        targets[i] = std::exp((values[i] - largest) / temperature);
+        sum += targets[i];
+    }
+    for (size_t i = 0; i < outputs_; ++i) {
+        targets[i] /= sum;
+    }
+}
+
+void TeacherCache::distillation_targets(size_t index, int label, double temperature, double alpha,
+                                        std::vector<double>& targets) const {
+    targets.resize(outputs_);
+    soft_targets(index, temperature, targets.data());
+    for (size_t i = 0; i < outputs_; ++i) {
+        const double hard = static_cast<int>(i) == label ? 1.0 : 0.0;
+        targets[i] = alpha * targets[i] + (1.0 - alpha) * hard;
+    }
+}
+
+} // namespace ANN
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../networks/networks.hpp"
+
+namespace ANN {
+
+    class TrainingSet;
+
+    //
+    // A trained teacher network's output logits for every instance of a training set, worked out
+    // once up front so distilling a student costs no teacher forward passes per epoch.
+    // Indexed like the training set, augmented samples use the logits of the image they came from.
+    //
+    class TeacherCache {
+    public:
+        // Runs the teacher over the set on threads copies of it, 0 = one per hardware thread
+        TeacherCache(const Network& teacher, const TrainingSet& training_set, unsigned int threads = 0);
+
+        size_t size() const { return outputs_ > 0 ? logits_.size() / outputs_ : 0; }
+        size_t outputs() const { return outputs_; }
+
+        const double* logits(size_t index) const { return logits_.data() + index * outputs_; }
+
+        // Softmax of the logits divided by temperature, higher temperatures spread the probability
+        // over the wrong classes and carry more of what the teacher learned (Hinton et al. 2015)
+        void soft_targets(size_t index, double temperature, double* targets) const;
+
+        //
+        // Target for one student step: alpha × the soft targets + (1 - alpha) × the one hot label
+        //
+        void distillation_targets(size_t index, int label, double temperature, double alpha, std::vector<double>& targets) const;
+
+    private:
+        size_t outputs_;
+        std::vector<double> logits_;    // [instance][output]
+    };
+
+} // namespace ANN
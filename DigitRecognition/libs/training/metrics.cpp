@@ -0,0 +1,250 @@
+#include "metrics.hpp"
+
+#include <iomanip>
+#include <nlohmann/json.hpp>
+
+namespace ANN {
+
+MetricsReporter::MetricsReporter(std::ostream* console, const std::string& csv_file, const std::string& jsonl_file,
+                                 size_t capacity, std::chrono::milliseconds poll_interval)
+    : ring_(capacity)
+    , console_(console)
+    , poll_interval_(poll_interval)
+    , start_(std::chrono::steady_clock::now())
+{
+    if (!csv_file.empty()) {
+        csv_.open(csv_file);
+        if (!csv_) {
+            throw std::runtime_error("Cannot open metrics file: " + csv_file);
+        }
+        csv_ << "epoch,total_loss,avg_loss,training_accuracy,samples,learning_rate\n";
+    }
+    if (!jsonl_file.empty()) {
+        jsonl_.open(jsonl_file);
+        if (!jsonl_) {
+            throw std::runtime_error("Cannot open metrics file: " + jsonl_file);
+        }
+    }
+    thread_ = std::thread(&MetricsReporter::run, this);
+}
+
+MetricsReporter::~MetricsReporter() {
+    close();
+}
+
+void MetricsReporter::epoch_start(int epoch, int epochs) {
+    MetricEvent event;
+    event.kind = MetricEvent::Kind::EpochStart;
+    event.epoch = epoch;
+    event.epochs = epochs;
+    push(event);
+}
+
+bool MetricsReporter::progress(int samples, size_t total, double accuracy) {
+    MetricEvent event;
+    event.kind = MetricEvent::Kind::Progress;
+    event.samples = samples;
+    event.total = static_cast<int>(total);
+    event.accuracy = accuracy;
+    event.time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+
+    // Never hold training up for a progress line, a later one replaces it
+    if (stop_.load(std::memory_order_relaxed) || !ring_.try_push(event)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    pushed_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+void MetricsReporter::epoch(const EpochStats& stats) {
+    MetricEvent event;
+    event.kind = MetricEvent::Kind::Epoch;
+    event.epoch = stats.epoch;
+    event.samples = stats.samples;
+    event.total_loss = stats.total_loss;
+    event.loss = stats.avg_loss;
+    event.accuracy = stats.accuracy;
+    event.learning_rate = stats.learning_rate;
+    event.milliseconds = stats.milliseconds;
+    push(event);
+}
+
+void MetricsReporter::validation(int epoch, double loss, double accuracy, bool improved) {
+    MetricEvent event;
+    event.kind = MetricEvent::Kind::Validation;
+    event.epoch = epoch;
+    event.loss = loss;
+    event.accuracy = accuracy;
+    event.improved = improved;
+    push(event);
+}
+
+void MetricsReporter::push(MetricEvent event) {
+    event.time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+
+    // Epoch results are not dropped, wait for the reporter to make room
+    while (!ring_.try_push(event)) {
+        if (stop_.load(std::memory_order_relaxed)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        std::this_thread::yield();
+    }
+    pushed_.fetch_add(1, std::memory_order_release);
+}
+
+void MetricsReporter::flush() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    const uint64_t target = pushed_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(written_mutex_);
+    flush_requested_ = true;
+    wake_.notify_one();
+    written_changed_.wait(lock, [&] { return written_ >= target; });
+}
+
+void MetricsReporter::close() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(written_mutex_);
+        stop_.store(true, std::memory_order_relaxed);
+    }
+    wake_.notify_one();
+    thread_.join();
+
+    if (csv_.is_open()) {
+        csv_.close();
+    }
+    if (jsonl_.is_open()) {
+        jsonl_.close();
+    }
+}
+
+void MetricsReporter::run() {
+    for (;;) {
+        drain();
+
+        std::unique_lock<std::mutex> lock(written_mutex_);
+        if (stop_.load(std::memory_order_relaxed)) {
+            break;
+        }
+        wake_.wait_for(lock, poll_interval_, [&] { return flush_requested_ || stop_.load(std::memory_order_relaxed); });
+        flush_requested_ = false;
+    }
+
+    // Producers see stop_ and no longer push, whatever made it in before is written
+    drain();
+}
+
+void MetricsReporter::drain() {
+    uint64_t taken = 0;
+    MetricEvent event;
+    MetricEvent latest_progress;
+    bool have_progress = false;
+
+    while (ring_.try_pop(event)) {
+        taken++;
+        if (event.kind == MetricEvent::Kind::Progress) {
+            // Only the newest progress line is worth showing, but every one goes to the stream
+            latest_progress = event;
+            have_progress = true;
+            if (jsonl_.is_open()) {
+                write(event);
+            }
+            continue;
+        }
+        // Anything else supersedes a progress line not yet shown
+        have_progress = false;
+        write(event);
+    }
+
+    if (have_progress && console_) {
+        *console_ << "Progress: " << latest_progress.samples << "/" << latest_progress.total
+                  << " Acc: " << std::fixed << std::setprecision(1) << latest_progress.accuracy << "% \r";
+    }
+
+    if (taken == 0) {
+        return;
+    }
+    if (console_) {
+        console_->flush();
+    }
+    if (jsonl_.is_open()) {
+        jsonl_.flush();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(written_mutex_);
+        written_ += taken;
+    }
+    written_changed_.notify_all();
+}
+
+void MetricsReporter::write(const MetricEvent& event) {
+    nlohmann::json line;
+    line["time_ms"] = event.time;
+
+    switch (event.kind) {
+        case MetricEvent::Kind::EpochStart:
+            if (console_) {
+                *console_ << "Epoch " << event.epoch << "/" << event.epochs << ": \n";
+            }
+            line["event"] = "epoch_start";
+            line["epoch"] = event.epoch;
+            line["epochs"] = event.epochs;
+            break;
+
+        case MetricEvent::Kind::Progress:
+            line["event"] = "progress";
+            line["samples"] = event.samples;
+            line["total"] = event.total;
+            line["accuracy"] = event.accuracy;
+            break;
+
+        case MetricEvent::Kind::Epoch:
+            if (console_) {
+                *console_ << "  Epoch " << event.epoch << " completed: " << event.samples << " samples"
+                          << " | Loss: " << std::fixed << std::setprecision(6) << event.loss
+                          << " | Train Acc: " << std::fixed << std::setprecision(2) << event.accuracy << "%"
+                          << " | LR: " << std::scientific << std::setprecision(3) << event.learning_rate << std::defaultfloat << "\n";
+            }
+            if (csv_.is_open()) {
+                csv_ << event.epoch << "," << event.total_loss << "," << event.loss << ","
+                     << event.accuracy << "," << event.samples << "," << event.learning_rate << "\n";
+                csv_.flush();  // a row per epoch, on disk as soon as the epoch is done
+            }
+            line["event"] = "epoch";
+            line["epoch"] = event.epoch;
+            line["samples"] = event.samples;
+            line["total_loss"] = event.total_loss;
+            line["avg_loss"] = event.loss;
+            line["accuracy"] = event.accuracy;
+            line["learning_rate"] = event.learning_rate;
+            line["epoch_ms"] = event.milliseconds;
+            break;
+
+        case MetricEvent::Kind::Validation:
+            if (console_) {
+                *console_ << "  Validation epoch " << event.epoch
+                          << " | Loss: " << std::fixed << std::setprecision(6) << event.loss
+                          << " | Acc: " << std::fixed << std::setprecision(2) << event.accuracy << "%"
+                          << (event.improved ? " (best)" : "") << "\n";
+            }
+            line["event"] = "validation";
+            line["epoch"] = event.epoch;
+            line["loss"] = event.loss;
+            line["accuracy"] = event.accuracy;
+            line["improved"] = event.improved;
+            break;
+    }
+
+    if (jsonl_.is_open()) {
+        jsonl_ << line.dump() << "\n";
+    }
+}
+
+} // namespace ANN
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "training.hpp"
+
+namespace ANN {
+
+    //
+    // Bounded multi producer, multi consumer queue without locks (D. Vyukov's design): every slot
+    // carries a sequence number that says whether it is free for the producer at a position or
+    // holds the value for the consumer at it, so a push or pop is one compare and swap on the
+    // shared position plus a release store on the slot. Capacity is rounded up to a power of two.
+    //
+    template <typename T>
+    class MetricsRing {
+        static_assert(std::is_trivially_copyable_v<T>, "MetricsRing holds plain values");
+
+    public:
+        explicit MetricsRing(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity) {
+                size *= 2;
+            }
+            mask_ = size - 1;
+            slots_ = std::make_unique<Slot[]>(size);
+            for (size_t i = 0; i < size; ++i) {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // False if the ring is full, the value is then not queued
+        bool try_push(const T& value)
+        {
+            size_t position = enqueue_position_.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = slots_[position & mask_];
+                const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+                if (difference == 0) {
+                    if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        slot.value = value;
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = enqueue_position_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // False if the ring is empty
+        bool try_pop(T& value)
+        {
+            size_t position = dequeue_position_.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = slots_[position & mask_];
+                const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+                if (difference == 0) {
+                    if (dequeue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        value = slot.value;
+                        slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = dequeue_position_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        size_t capacity() const { return mask_ + 1; }
+
+    private:
+        struct Slot {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        // Producers and consumers each on their own cache line
+        alignas(64) std::atomic<size_t> enqueue_position_{0};
+        alignas(64) std::atomic<size_t> dequeue_position_{0};
+        alignas(64) size_t mask_ = 0;
+        std::unique_ptr<Slot[]> slots_;
+    };
+
+    //
+    // One training metric as it travels from a training or validation thread to the reporter
+    //
+    struct MetricEvent {
+        enum class Kind : uint8_t { EpochStart, Progress, Epoch, Validation };
+
+        Kind kind = Kind::Progress;
+        int epoch = 0;              // 1 based
+        int epochs = 0;             // EpochStart: epochs planned
+        int samples = 0;            // Progress: samples so far, Epoch: samples in the epoch
+        int total = 0;              // Progress: samples in the epoch
+        double total_loss = 0.0;
+        double loss = 0.0;          // average loss
+        double accuracy = 0.0;      // percent
+        double learning_rate = 0.0;
+        double milliseconds = 0.0;  // Epoch: wall time of the epoch
+        double time = 0.0;          // milliseconds since the reporter started, when the event was pushed
+        bool improved = false;      // Validation: best loss so far
+    };
+
+    //
+    // Formats and writes training metrics on a thread of its own, so training threads only copy a
+    // small struct into a lock-free ring. Writes the console progress line and per epoch summary,
+    // the loss CSV (one row per epoch, flushed per epoch) and, optionally, a JSON lines stream of
+    // every event. Progress events are dropped when the ring is full, the reporter then simply
+    // shows a later one; epoch and validation events wait for space instead.
+    //
+    class MetricsReporter {
+    public:
+        // nullptr console or an empty filename turns that output off. Throws if a file cannot be opened.
+        MetricsReporter(std::ostream* console, const std::string& csv_file, const std::string& jsonl_file,
+                        size_t capacity = 1024, std::chrono::milliseconds poll_interval = std::chrono::milliseconds(50));
+        ~MetricsReporter();
+
+        MetricsReporter(const MetricsReporter&) = delete;
+        MetricsReporter& operator=(const MetricsReporter&) = delete;
+
+        // Producers, any thread. progress() returns false if the event was dropped.
+        void epoch_start(int epoch, int epochs);
+        bool progress(int samples, size_t total, double accuracy);
+        void epoch(const EpochStats& stats);
+        void validation(int epoch, double loss, double accuracy, bool improved);
+
+        // Wait until everything pushed so far is written, e.g. before printing to the console directly
+        void flush();
+
+        // Write what is left, stop the thread and close the files. Called by the destructor.
+        void close();
+
+        uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        void push(MetricEvent event);  // waits for space
+        void run();
+        void drain();
+        void write(const MetricEvent& event);
+
+        MetricsRing<MetricEvent> ring_;
+        std::ostream* console_;
+        std::ofstream csv_;
+        std::ofstream jsonl_;
+        std::chrono::milliseconds poll_interval_;
+        std::chrono::steady_clock::time_point start_;
+
+        std::atomic<uint64_t> pushed_{0};
+        std::atomic<uint64_t> dropped_{0};
+        std::atomic<bool> stop_{false};
+
+        // Only flush(), close() and the reporter thread use these, producers never touch them
+        std::mutex written_mutex_;
+        std::condition_variable written_changed_;
+        std::condition_variable wake_;
+        uint64_t written_ = 0;      // events taken off the ring
+        bool flush_requested_ = false;
+
+        std::thread thread_;
+    };
+
+} // namespace ANN
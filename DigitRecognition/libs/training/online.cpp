@@ -0,0 +1,121 @@
+#include "online.hpp"
+
+#include <stdexcept>
+
+namespace ANN {
+
+ReplayBuffer::ReplayBuffer(size_t capacity, unsigned int seed)
+    : capacity_(capacity)
+    , rng_(seed)
+{
+    instances_.reserve(capacity_);
+}
+
+void ReplayBuffer::add(const TrainingInstance& instance) {
+    seen_++;
+    if (instances_.size() < capacity_) {
+        instances_.push_back(instance);
+        return;
+    }
+    // Algorithm R, the new instance replaces a kept one with probability capacity / seen
+    const uint64_t slot = std::uniform_int_distribution<uint64_t>(0, seen_ - 1)(rng_);
+    if (slot < capacity_) {
+        instances_[slot] = instance;
+    }
+}
+
+const TrainingInstance& ReplayBuffer::sample() {
+    if (instances_.empty()) {
+        throw std::runtime_error("Sampling from an empty replay buffer");
+    }
+    return instances_[std::uniform_int_distribution<size_t>(0, instances_.size() - 1)(rng_)];
+}
+
+OnlineLearner::OnlineLearner(const Network& network, const Config::OnlineConfig& config, unsigned int seed)
+    : config_(config)
+    , working_(network)
+    , replay_(static_cast<size_t>(config.replay_capacity), seed)
+{
+    // working_ is a copy, so update() on another thread never times into the owner's profiler or counters
+    auto initial = std::make_shared<Network>(working_);
+    initial->set_inference_mode(true);
+    published_ = std::move(initial);
+
+    working_.set_learning_rate(config_.learning_rate);
+}
+
+std::vector<double> OnlineLearner::predict_probabilities(const std::vector<double>& input_data) const {
+    // The reference keeps this snapshot alive even if update() publishes a new one meanwhile
+    const std::shared_ptr<const Network> network = snapshot();
+    if (input_data.size() != network->input_size()) {
+        throw std::runtime_error("Input size mismatch: expected " + std::to_string(network->input_size()) +
+                                 ", got " + std::to_string(input_data.size()));
+    }
+
+    // infer_batch leaves the network untouched, each reader thread brings its own workspace
+    thread_local InferenceWorkspace workspace;
+    return network->infer_batch(input_data.data(), 1, workspace);
+}
+
+int OnlineLearner::predict_label(const std::vector<double>& input_data) const {
+    auto outputs = predict_probabilities(input_data);
+    return argmax(outputs.data(), outputs.size());
+}
+
+void OnlineLearner::remember(const TrainingSet& training_set) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    for (const auto& instance : training_set.get_instances()) {
+        replay_.add(instance);
+    }
+}
+
+OnlineUpdateStats OnlineLearner::update(const TrainingSet& corrections) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    OnlineUpdateStats stats;
+
+    int since_publish = 0;
+    for (const auto& instance : corrections.get_instances()) {
+        stats.avg_loss += working_.train(instance.input_data, instance.label).loss;
+        stats.samples++;
+
+        // Rehearse before the new sample joins the buffer, so it is not simply repeated
+        for (int r = 0; r < config_.replay_ratio && !replay_.empty(); ++r) {
+            const TrainingInstance& old = replay_.sample();
+            working_.train(old.input_data, old.label);
+            stats.replayed++;
+        }
+        replay_.add(instance);
+
+        if (config_.publish_interval > 0 && ++since_publish >= config_.publish_interval) {
+            publish();
+            stats.publishes++;
+            since_publish = 0;
+        }
+    }
+
+    if (stats.samples > 0) {
+        stats.avg_loss /= stats.samples;
+        if (since_publish > 0 || config_.publish_interval == 0) {
+            publish();
+            stats.publishes++;
+        }
+    }
+    stats.version = version();
+    return stats;
+}
+
+size_t OnlineLearner::replay_size() const {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    return replay_.size();
+}
+
+void OnlineLearner::publish() {
+    // Readers holding the previous snapshot keep it, the last of them frees it.
+    // Snapshots only predict, so they carry no gradient block.
+    auto copy = std::make_shared<Network>(working_);
+    copy->set_inference_mode(true);
+    std::atomic_store_explicit(&published_, std::shared_ptr<const Network>(std::move(copy)), std::memory_order_release);
+    version_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+} // namespace ANN
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "training.hpp"
+
+namespace ANN {
+
+    //
+    // Bounded store of past samples to rehearse while learning new ones, so a deployed network
+    // does not forget what it was trained on. Reservoir sampling keeps a uniform sample of
+    // everything ever added, however long the stream, in at most capacity instances.
+    //
+    class ReplayBuffer {
+    public:
+        ReplayBuffer(size_t capacity, unsigned int seed = std::random_device{}());
+
+        // Keep instance with probability capacity / seen(), replacing a random kept one
+        void add(const TrainingInstance& instance);
+
+        // A kept instance drawn uniformly, the buffer must not be empty
+        const TrainingInstance& sample();
+
+        size_t size() const { return instances_.size(); }
+        size_t capacity() const { return capacity_; }
+        bool empty() const { return instances_.empty(); }
+        uint64_t seen() const { return seen_; }    // instances ever added
+        const std::vector<TrainingInstance>& instances() const { return instances_; }
+
+    private:
+        size_t capacity_;
+        uint64_t seen_ = 0;
+        std::vector<TrainingInstance> instances_;
+        std::mt19937_64 rng_;
+    };
+
+    //
+    // What one OnlineLearner::update did
+    //
+    struct OnlineUpdateStats {
+        int samples = 0;            // new samples learnt
+        int replayed = 0;           // replay buffer samples rehearsed alongside them
+        double avg_loss = 0.0;      // over the new samples, before each one's step
+        int publishes = 0;          // weight swaps made
+        uint64_t version = 0;       // version readers see after the update
+    };
+
+    //
+    // Keeps learning from newly labelled samples while serving predictions.
+    //
+    // The trainer works on a private copy of the network. Every config.publish_interval new
+    // samples (or once per update) it publishes a fresh immutable copy with an atomic pointer
+    // swap: read-copy-update. Readers load the pointer and predict from that snapshot, never
+    // waiting on training; a snapshot stays valid for as long as a reader holds it and is freed
+    // with its last reference. Each new sample is followed by config.replay_ratio samples
+    // rehearsed from the replay buffer, then joins the buffer itself.
+    //
+    // Any number of threads may predict. update() calls are serialised with each other only.
+    //
+    class OnlineLearner {
+    public:
+        OnlineLearner(const Network& network, const Config::OnlineConfig& config,
+                      unsigned int seed = std::random_device{}());
+
+        // Current published network, immutable, safe to keep and use from any thread
+        std::shared_ptr<const Network> snapshot() const { return std::atomic_load_explicit(&published_, std::memory_order_acquire); }
+
+        // Predict from the current snapshot, never waits for update()
+        std::vector<double> predict_probabilities(const std::vector<double>& input_data) const;
+        int predict_label(const std::vector<double>& input_data) const;
+
+        // Number of snapshots published so far, 0 is the network the learner was built with
+        uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+        // Put the samples the network was originally trained on in the replay buffer, so
+        // rehearsal covers them as well as earlier corrections
+        void remember(const TrainingSet& training_set);
+
+        // Learn from newly labelled samples, publishing as configured and once at the end
+        OnlineUpdateStats update(const TrainingSet& corrections);
+
+        size_t replay_size() const;
+
+    private:
+        void publish();
+
+        Config::OnlineConfig config_;
+        mutable std::mutex writer_mutex_;   // serialises update() and remember(), readers never take it
+        Network working_;
+        ReplayBuffer replay_;
+        // Only touched through std::atomic_load/atomic_store, std::atomic<std::shared_ptr> needs GCC 12 and libc++ lacks it
+        std::shared_ptr<const Network> published_;
+        std::atomic<uint64_t> version_{0};
+    };
+
+} // namespace ANN
@@ -0,0 +1,158 @@
+#include "../augmentation.hpp"
+#include "../training.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+static ANN::Augmenter::Settings no_augmentation() {
+    ANN::Augmenter::Settings settings{};
+    settings.enabled = true;
+    settings.elastic_sigma = 4.0;
+    settings.threads = 2;
+    settings.batch_size = 4;
+    settings.queue_batches = 2;
+    return settings;
+}
+
+// 28x28 image with a bright square off centre
+static std::vector<double> make_image() {
+    std::vector<double> image(28 * 28, 0.0);
+    for (int y = 8; y < 14; ++y) {
+        for (int x = 10; x < 18; ++x) {
+            image[y * 28 + x] = 1.0;
+        }
+    }
+    return image;
+}
+
+bool test_identity() {
+    std::cout << "Testing augmentation with every range at zero..." << std::endl;
+
+    ANN::Augmenter augmenter(no_augmentation(), 28, 28);
+    ANN::AugmentWorkspace workspace;
+    auto image = make_image();
+    std::vector<double> output;
+    augmenter.apply(image, output, 0, 5, workspace);
+
+    ASSERT_TRUE(output.size() == image.size());
+    for (size_t i = 0; i < image.size(); ++i) {
+        ASSERT_NEAR(output[i], image[i], 1e-12);
+    }
+
+    std::cout << "✓ Identity tests passed" << std::endl;
+    return true;
+}
+
+bool test_transforms() {
+    std::cout << "Testing shifts, elastic distortion and noise..." << std::endl;
+
+    auto image = make_image();
+    const double ink = std::accumulate(image.begin(), image.end(), 0.0);
+    ANN::AugmentWorkspace workspace;
+    std::vector<double> first, second, other;
+
+    // Shift and rotate moves the square but keeps roughly the same amount of ink
+    auto settings = no_augmentation();
+    settings.shift = 3.0;
+    settings.rotation = 15.0;
+    settings.elastic_alpha = 34.0;
+    ANN::Augmenter augmenter(settings, 28, 28, 1.0, 99);
+
+    augmenter.apply(image, first, 2, 7, workspace);
+    augmenter.apply(image, second, 2, 7, workspace);
+    augmenter.apply(image, other, 3, 7, workspace);
+    ASSERT_TRUE(first == second);       // same seed, epoch and sample, same draw
+    ASSERT_TRUE(first != other);        // another epoch, another draw
+    ASSERT_TRUE(first != image);
+    ASSERT_NEAR(std::accumulate(first.begin(), first.end(), 0.0), ink, ink * 0.35);
+
+    // Noise stays inside the pixel range
+    settings = no_augmentation();
+    settings.noise = 0.5;
+    ANN::Augmenter noisy(settings, 28, 28, 1.0, 1);
+    noisy.apply(image, first, 0, 0, workspace);
+    ASSERT_TRUE(std::ranges::all_of(first, [](double v) { return v >= 0.0 && v <= 1.0; }));
+    ASSERT_TRUE(first != image);
+
+    std::cout << "✓ Transform tests passed" << std::endl;
+    return true;
+}
+
+bool test_pipeline_order() {
+    std::cout << "Testing the augmentation pipeline keeps training order..." << std::endl;
+
+    ANN::TrainingSet training_set;
+    for (int i = 0; i < 37; ++i) {
+        auto image = make_image();
+        image[i] = 0.5;
+        training_set.add_instance({image, i % 10, ""});
+    }
+    std::vector<size_t> order(37);
+    std::iota(order.rbegin(), order.rend(), size_t(0));   // reversed
+
+    auto settings = no_augmentation();
+    settings.shift = 2.0;
+    ANN::Augmenter augmenter(settings, 28, 28, 1.0, 5);
+
+    ANN::AugmentWorkspace workspace;
+    std::vector<double> expected;
+    size_t position = 0;
+    {
+        ANN::AugmentationPipeline pipeline(training_set, order, augmenter, 1);
+        while (const ANN::AugmentedBatch* batch = pipeline.next()) {
+            for (size_t i = 0; i < batch->inputs.size(); ++i, ++position) {
+                const auto& instance = training_set.get_instances()[order[position]];
+                augmenter.apply(instance.input_data, expected, 1, order[position], workspace);
+                ASSERT_TRUE(batch->labels[i] == instance.label);
+                ASSERT_TRUE(batch->inputs[i] == expected);
+            }
+        }
+    }
+    ASSERT_TRUE(position == order.size());
+
+    // Dropping the pipeline early must not hang
+    {
+        ANN::AugmentationPipeline pipeline(training_set, order, augmenter, 2);
+        ASSERT_TRUE(pipeline.next() != nullptr);
+    }
+
+    std::cout << "✓ Pipeline tests passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Augmentation Tests" << std::endl;
+    std::cout << "==========================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_identity();
+    all_passed &= test_transforms();
+    all_passed &= test_pipeline_order();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
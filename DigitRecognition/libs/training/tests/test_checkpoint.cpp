@@ -0,0 +1,241 @@
+#include "../checkpoint.hpp"
+#include "test_fixtures.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+static ANN::Config make_config(const std::string& directory) {
+    ANN::Config config = make_base_config(3);
+    config.training.learning_rate.schedule = "cosine";
+    config.training.learning_rate.update = "iteration";
+    config.training.augmentation.threads = 2;
+    config.training.augmentation.batch_size = 16;
+    config.training.augmentation.queue_batches = 3;
+    config.training.augmentation.shift = 1.0;
+    config.training.augmentation.noise = 0.05;
+    config.training.checkpoint.enabled = true;
+    config.training.checkpoint.directory = directory;
+    config.training.checkpoint.delta = true;
+    config.training.checkpoint.full_interval = 3;
+
+    std::filesystem::remove_all(directory);
+    return config;
+}
+
+static size_t file_count(const std::string& directory) {
+    return static_cast<size_t>(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator{}));
+}
+
+bool test_delta_round_trip() {
+    std::cout << "Testing full and delta checkpoints..." << std::endl;
+
+    const std::string directory = "test_checkpoints_delta";
+    ANN::Config config = make_config(directory);
+    auto data_set = make_data_set(64);
+    ANN::Network network = make_network(5);
+    ANN::Trainer trainer(network, config.training, 1);
+
+    {
+        ANN::AsyncCheckpointWriter writer(config.training.checkpoint);
+        for (int epoch = 0; epoch < 6; ++epoch) {
+            trainer.run_epoch(data_set, epoch);
+            ANN::TrainingState state;
+            state.epoch = epoch + 1;
+            state.rng = "state " + std::to_string(epoch);
+            state.order = {3, 1, 2, 0};
+            ASSERT_TRUE(writer.submit(network, state));
+            writer.wait();
+
+            // Every checkpoint, full or delta, reads back bit for bit
+            auto latest = ANN::load_latest_checkpoint(directory);
+            ASSERT_TRUE(latest.has_value());
+            ASSERT_TRUE(latest->sequence == static_cast<uint64_t>(epoch + 1));
+            ASSERT_TRUE(std::ranges::equal(latest->parameters, network.parameters()));
+            ASSERT_TRUE(latest->state.epoch == epoch + 1 && latest->state.rng == state.rng && latest->state.order == state.order);
+            ASSERT_TRUE(latest->header.layer_sizes == network.layer_sizes());
+        }
+        ASSERT_TRUE(writer.written() == 6 && writer.failed() == 0);
+    }
+
+    // 1 full, 2-3 delta, 4 full (1-3 removed), 5-6 delta
+    ASSERT_TRUE(file_count(directory) == 3);
+    const auto full_size = std::filesystem::file_size(directory + "/checkpoint_00000004.ckpt");
+    const auto delta_size = std::filesystem::file_size(directory + "/checkpoint_00000005.ckpt");
+    std::cout << "  full " << full_size << " bytes, delta " << delta_size << " bytes" << std::endl;
+    ASSERT_TRUE(delta_size < full_size);
+
+    std::cout << "✓ Full and delta checkpoints passed" << std::endl;
+    return true;
+}
+
+bool test_damaged_checkpoints() {
+    std::cout << "Testing damaged and interrupted checkpoints..." << std::endl;
+
+    const std::string directory = "test_checkpoints_damaged";
+    ANN::Config config = make_config(directory);
+    ANN::Network network = make_network(5);
+    {
+        ANN::AsyncCheckpointWriter writer(config.training.checkpoint);
+        writer.submit(network, ANN::TrainingState{});
+        writer.wait();
+    }
+
+    // A newer checkpoint cut short and a write that never got renamed into place
+    std::filesystem::copy_file(directory + "/checkpoint_00000001.ckpt", directory + "/checkpoint_00000002.ckpt");
+    std::filesystem::resize_file(directory + "/checkpoint_00000002.ckpt", 200);
+    std::ofstream(directory + "/checkpoint_00000003.ckpt.tmp") << "partial";
+
+    bool threw = false;
+    try {
+        ANN::read_checkpoint(directory + "/checkpoint_00000002.ckpt");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    auto latest = ANN::load_latest_checkpoint(directory);
+    ASSERT_TRUE(latest.has_value() && latest->sequence == 1);
+
+    // A new writer clears the partial write and numbers on from the newest file
+    {
+        ANN::AsyncCheckpointWriter writer(config.training.checkpoint);
+        ASSERT_TRUE(!std::filesystem::exists(directory + "/checkpoint_00000003.ckpt.tmp"));
+        writer.submit(network, ANN::TrainingState{});
+        writer.wait();
+        ASSERT_TRUE(std::filesystem::path(writer.last_file()).filename() == "checkpoint_00000003.ckpt");
+    }
+
+    // Checkpoints only restore into the network they were taken from
+    ANN::Network other({16, 8, 10});
+    threw = false;
+    try {
+        ANN::restore_checkpoint(*latest, other);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    std::filesystem::remove_all(directory);
+    std::cout << "✓ Damaged and interrupted checkpoints passed" << std::endl;
+    return true;
+}
+
+struct Preempted {};
+
+bool test_resume(bool augment) {
+    std::cout << "Testing resuming part way through an epoch" << (augment ? " with augmentation" : "") << "..." << std::endl;
+
+    const std::string directory = "test_checkpoints_resume";
+    ANN::Config config = make_config(directory);
+    auto data_set = make_data_set(200);
+    config.training.augmentation.enabled = augment;
+    auto make_augmenter = [&](uint64_t seed) {
+        return std::make_unique<ANN::Augmenter>(config.training.augmentation, 4, 4, 1.0, seed);
+    };
+
+    // Uninterrupted reference run
+    ANN::Network reference = make_network(11);
+    ANN::Trainer reference_trainer(reference, config.training, 3);
+    auto reference_augmenter = make_augmenter(99);
+    if (augment) {
+        reference_trainer.set_augmenter(reference_augmenter.get());
+    }
+    auto reference_history = reference_trainer.run(data_set);
+
+    // Same run, checkpointed every 37 samples and killed 74 samples into the second epoch
+    {
+        ANN::Network network = make_network(11);
+        ANN::Trainer trainer(network, config.training, 3);
+        auto augmenter = make_augmenter(99);
+        if (augment) {
+            trainer.set_augmenter(augmenter.get());
+        }
+        ANN::AsyncCheckpointWriter writer(config.training.checkpoint);
+        trainer.on_checkpoint([&](const ANN::TrainingState& state) {
+            writer.submit(network, state);
+            if (state.epoch == 1 && state.position == 74) {
+                writer.wait();
+                throw Preempted{};
+            }
+        }, 37);
+
+        bool preempted = false;
+        try {
+            trainer.run(data_set);
+        } catch (const Preempted&) {
+            preempted = true;
+        }
+        ASSERT_TRUE(preempted);
+    }
+
+    auto checkpoint = ANN::load_latest_checkpoint(directory);
+    ASSERT_TRUE(checkpoint.has_value());
+    ASSERT_TRUE(checkpoint->state.epoch == 1 && checkpoint->state.position == 74);
+    ASSERT_TRUE(checkpoint->state.augment_seed == (augment ? 99u : 0u));
+
+    // A fresh process: other initial weights and shuffle seed, both replaced by the checkpoint
+    ANN::Network resumed = make_network(12);
+    ANN::restore_checkpoint(*checkpoint, resumed);
+    ANN::Trainer trainer(resumed, config.training, 777);
+    auto augmenter = make_augmenter(checkpoint->state.augment_seed);
+    if (augment) {
+        trainer.set_augmenter(augmenter.get());
+    }
+    trainer.restore(checkpoint->state);
+    auto history = trainer.run(data_set);
+
+    // Bit for bit where the uninterrupted run ended, with the same epoch statistics
+    ASSERT_TRUE(history.size() == 2);
+    ASSERT_TRUE(std::ranges::equal(resumed.parameters(), reference.parameters()));
+    for (size_t i = 0; i < history.size(); ++i) {
+        ASSERT_TRUE(history[i].epoch == reference_history[i + 1].epoch);
+        ASSERT_TRUE(history[i].samples == reference_history[i + 1].samples);
+        ASSERT_TRUE(history[i].total_loss == reference_history[i + 1].total_loss);
+        ASSERT_TRUE(history[i].accuracy == reference_history[i + 1].accuracy);
+    }
+
+    std::filesystem::remove_all(directory);
+    std::cout << "✓ Resume" << (augment ? " with augmentation" : "") << " passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Checkpoint Tests" << std::endl;
+    std::cout << "========================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_delta_round_trip();
+    all_passed &= test_damaged_checkpoints();
+    all_passed &= test_resume(false);
+    all_passed &= test_resume(true);
+    std::filesystem::remove_all("test_checkpoints_delta");
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
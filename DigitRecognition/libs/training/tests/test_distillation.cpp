@@ -0,0 +1,153 @@
+#include "../distillation.hpp"
+#include "../training.hpp"
+#include "test_fixtures.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+static ANN::Config::TrainingConfig make_training_config(int epochs) {
+    ANN::Config config = make_base_config(epochs);
+    config.training.distillation.temperature = 2.0;
+    config.training.distillation.alpha = 0.7;
+    return config.training;
+}
+
+bool test_one_hot_target() {
+    std::cout << "Testing training towards a target vector..." << std::endl;
+
+    auto data_set = make_data_set(8);
+    ANN::Network by_label = make_network(3, {16, 8, 10});
+    ANN::Network by_target = make_network(3, {16, 8, 10});
+    for (const auto& instance : data_set.get_instances()) {
+        auto a = by_label.train(instance.input_data, instance.label);
+        auto b = by_target.train(instance.input_data, ANN::label_to_one_hot_vector(instance.label));
+        ASSERT_NEAR(a.loss, b.loss, 0.0);
+    }
+    ASSERT_TRUE(std::ranges::equal(by_label.parameters(), by_target.parameters()));
+
+    bool threw = false;
+    try {
+        by_target.train(data_set.get_instances()[0].input_data, std::vector<double>(4, 0.0));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    std::cout << "✓ Target vector training passed" << std::endl;
+    return true;
+}
+
+bool test_teacher_cache() {
+    std::cout << "Testing the teacher output cache..." << std::endl;
+
+    auto data_set = make_data_set(37);
+    ANN::Network teacher = make_network(11, {16, 24, 10});
+    ANN::TeacherCache single(teacher, data_set, 1);
+    ANN::TeacherCache threaded(teacher, data_set, 3);
+    ASSERT_TRUE(single.size() == 37 && single.outputs() == 10);
+
+    for (size_t i = 0; i < data_set.get_instances().size(); ++i) {
+        auto logits = teacher.predict_logits(data_set.get_instances()[i].input_data);
+        for (size_t o = 0; o < logits.size(); ++o) {
+            ASSERT_NEAR(single.logits(i)[o], logits[o], 0.0);
+            ASSERT_NEAR(threaded.logits(i)[o], logits[o], 0.0);
+        }
+    }
+
+    // Soft targets are a distribution that flattens as the temperature rises
+    std::vector<double> cool(10), warm(10);
+    single.soft_targets(5, 1.0, cool.data());
+    single.soft_targets(5, 8.0, warm.data());
+    ASSERT_NEAR(std::accumulate(cool.begin(), cool.end(), 0.0), 1.0, 1e-12);
+    ASSERT_NEAR(std::accumulate(warm.begin(), warm.end(), 0.0), 1.0, 1e-12);
+    ASSERT_TRUE(*std::ranges::max_element(warm) < *std::ranges::max_element(cool));
+    ASSERT_TRUE(std::ranges::max_element(warm) - warm.begin() == std::ranges::max_element(cool) - cool.begin());
+
+    // alpha 0 is the label alone, alpha 1 the teacher alone
+    std::vector<double> targets;
+    single.distillation_targets(5, 1, 2.0, 0.0, targets);
+    ASSERT_TRUE(targets == ANN::label_to_one_hot_vector(1));
+    single.distillation_targets(5, 1, 2.0, 1.0, targets);
+    std::vector<double> soft(10);
+    single.soft_targets(5, 2.0, soft.data());
+    for (size_t o = 0; o < 10; ++o) {
+        ASSERT_NEAR(targets[o], soft[o], 1e-15);
+    }
+
+    std::cout << "✓ Teacher cache passed" << std::endl;
+    return true;
+}
+
+bool test_distillation() {
+    std::cout << "Testing distilling a small student from a trained teacher..." << std::endl;
+
+    auto data_set = make_data_set(200);
+
+    ANN::Network teacher = make_network(21, {16, 32, 10});
+    ANN::Trainer(teacher, make_training_config(10), 1).run(data_set);
+    const double teacher_accuracy = accuracy(teacher, data_set);
+    ASSERT_TRUE(teacher_accuracy > 95.0);
+
+    ANN::TeacherCache cache(teacher, data_set, 2);
+    ANN::Network student = make_network(22, {16, 6, 10});
+    ANN::Trainer trainer(student, make_training_config(10), 2);
+    trainer.set_teacher(&cache);
+    auto history = trainer.run(data_set);
+    const double student_accuracy = accuracy(student, data_set);
+
+    std::cout << "  teacher " << teacher_accuracy << "%, student " << student_accuracy << "%, final loss "
+              << history.back().avg_loss << std::endl;
+    ASSERT_TRUE(history.back().avg_loss < history.front().avg_loss);
+    ASSERT_TRUE(student_accuracy > 90.0);
+
+    // A teacher with a different number of outputs is refused
+    ANN::Network wrong_teacher = make_network(23, {16, 8, 4});
+    ANN::TeacherCache wrong_cache(wrong_teacher, data_set, 1);
+    bool threw = false;
+    try {
+        trainer.set_teacher(&wrong_cache);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    std::cout << "✓ Distillation passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Distillation Tests" << std::endl;
+    std::cout << "==========================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_one_hot_target();
+    all_passed &= test_teacher_cache();
+    all_passed &= test_distillation();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+// Small data sets and networks shared by the training and distributed tests
+
+#include "../training.hpp"
+#include "../../config/config.hpp"
+#include "../../networks/networks.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Each class lights its own quarter of a 16 pixel input, with a little overlap into the next
+inline ANN::TrainingSet make_data_set(size_t count, int first_class = 0, int classes = 4) {
+    ANN::TrainingSet data_set;
+    for (size_t i = 0; i < count; ++i) {
+        ANN::TrainingInstance instance;
+        instance.label = first_class + static_cast<int>(i % classes);
+        instance.input_data.assign(16, 0.0);
+        for (int p = 0; p < 5; ++p) {
+            instance.input_data[(instance.label * 4 + p) % 16] = 0.5 + 0.1 * ((i / classes + p) % 5);
+        }
+        data_set.add_instance(std::move(instance));
+    }
+    return data_set;
+}
+
+// Sigmoid network with seeded uniform weights, the same for the same seed
+inline ANN::Network make_network(uint64_t seed, const std::vector<int>& layers = {16, 16, 10},
+                                 const ANN::LearningRateConfig& learning_rate = {}) {
+    ANN::WeightInitConfig weight_config;
+    weight_config.method = "uniform";
+    weight_config.range = {-0.5, 0.5};
+    weight_config.seed = seed;
+    return ANN::Network(layers, weight_config, learning_rate, "sigmoid");
+}
+
+// Defaults for everything, plain SGD at a rate the data sets above learn quickly with
+inline ANN::Config make_base_config(int epochs) {
+    ANN::Config config(nlohmann::json::object());
+    config.training.epochs = epochs;
+    config.training.learning_rate.initial = 0.5;
+    config.training.learning_rate.schedule = "constant";
+    return config;
+}
+
+// Percentage of data_set a Network or OnlineLearner labels correctly
+template <typename Model>
+double accuracy(Model& model, const ANN::TrainingSet& data_set) {
+    int correct = 0;
+    for (const auto& instance : data_set.get_instances()) {
+        correct += model.predict_label(instance.input_data) == instance.label;
+    }
+    return 100.0 * correct / data_set.get_instances().size();
+}
@@ -0,0 +1,232 @@
+#include "../metrics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+static std::vector<std::string> read_lines(const std::string& filename) {
+    std::vector<std::string> lines;
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+bool test_ring_single_thread() {
+    std::cout << "Testing metrics ring..." << std::endl;
+
+    ANN::MetricsRing<int> ring(5);
+    ASSERT_TRUE(ring.capacity() == 8);
+
+    int value = -1;
+    ASSERT_TRUE(!ring.try_pop(value));
+
+    // Fills up, then refuses, and hands values back in order; twice round to wrap
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            ASSERT_TRUE(ring.try_push(round * 100 + i));
+        }
+        ASSERT_TRUE(!ring.try_push(999));
+        for (int i = 0; i < 8; ++i) {
+            ASSERT_TRUE(ring.try_pop(value));
+            ASSERT_TRUE(value == round * 100 + i);
+        }
+        ASSERT_TRUE(!ring.try_pop(value));
+    }
+
+    std::cout << "✓ Metrics ring passed" << std::endl;
+    return true;
+}
+
+bool test_ring_concurrent() {
+    std::cout << "Testing metrics ring with several producers..." << std::endl;
+
+    const int producers = 4;
+    const int per_producer = 50000;
+    ANN::MetricsRing<int> ring(64);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; ++i) {
+                while (!ring.try_push(p * per_producer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Every value arrives exactly once, and each producer's values in the order pushed
+    std::vector<int> seen(producers * per_producer, 0);
+    std::vector<int> last(producers, -1);
+    bool ordered = true;
+    int received = 0;
+    int value = 0;
+    while (received < producers * per_producer) {
+        if (!ring.try_pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        seen[value]++;
+        const int producer = value / per_producer;
+        ordered = ordered && value % per_producer > last[producer];
+        last[producer] = value % per_producer;
+        received++;
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_TRUE(ordered);
+    ASSERT_TRUE(std::ranges::all_of(seen, [](int count) { return count == 1; }));
+    ASSERT_TRUE(!ring.try_pop(value));
+
+    std::cout << "✓ Metrics ring with several producers passed" << std::endl;
+    return true;
+}
+
+bool test_reporter_outputs() {
+    std::cout << "Testing metrics reporter outputs..." << std::endl;
+
+    const std::string csv_filename = "test_metrics_loss.csv";
+    const std::string jsonl_filename = "test_metrics_stream.jsonl";
+    std::ostringstream console;
+    {
+        ANN::MetricsReporter reporter(&console, csv_filename, jsonl_filename, 16, std::chrono::milliseconds(5));
+
+        for (int e = 1; e <= 2; ++e) {
+            reporter.epoch_start(e, 2);
+            reporter.progress(100, 200, 50.0);
+            ANN::EpochStats stats;
+            stats.epoch = e;
+            stats.total_loss = 10.0 * e;
+            stats.avg_loss = 0.05 * e;
+            stats.accuracy = 90.0 + e;
+            stats.samples = 200;
+            stats.learning_rate = 0.1;
+            reporter.epoch(stats);
+        }
+
+        // Validation comes from its own thread
+        std::thread validator([&] { reporter.validation(2, 0.25, 88.5, true); });
+        validator.join();
+
+        // Everything pushed so far is on the console once flush returns
+        reporter.flush();
+        const std::string text = console.str();
+        ASSERT_TRUE(text.find("Epoch 1/2: \n") != std::string::npos);
+        ASSERT_TRUE(text.find("  Epoch 2 completed: 200 samples | Loss: 0.100000 | Train Acc: 92.00% | LR: 1.000e-01\n") != std::string::npos);
+        ASSERT_TRUE(text.find("  Validation epoch 2 | Loss: 0.250000 | Acc: 88.50% (best)\n") != std::string::npos);
+        ASSERT_TRUE(text.find("Epoch 1/2") < text.find("Epoch 1 completed"));
+        ASSERT_TRUE(text.find("Epoch 1 completed") < text.find("Epoch 2/2"));
+        ASSERT_TRUE(reporter.dropped() == 0);
+    }
+
+    const auto csv = read_lines(csv_filename);
+    ASSERT_TRUE(csv.size() == 3);
+    ASSERT_TRUE(csv[0] == "epoch,total_loss,avg_loss,training_accuracy,samples,learning_rate");
+    ASSERT_TRUE(csv[1] == "1,10,0.05,91,200,0.1");
+    ASSERT_TRUE(csv[2] == "2,20,0.1,92,200,0.1");
+
+    const auto jsonl = read_lines(jsonl_filename);
+    ASSERT_TRUE(jsonl.size() == 7);
+    int epochs = 0;
+    double previous_time = 0.0;
+    for (const auto& line : jsonl) {
+        auto event = nlohmann::json::parse(line);
+        ASSERT_TRUE(event["time_ms"].get<double>() >= previous_time);
+        previous_time = event["time_ms"].get<double>();
+        if (event["event"] == "epoch") {
+            epochs++;
+            ASSERT_NEAR(event["avg_loss"].get<double>(), 0.05 * event["epoch"].get<int>(), 1e-12);
+        }
+    }
+    ASSERT_TRUE(epochs == 2);
+    ASSERT_TRUE(nlohmann::json::parse(jsonl.back())["event"] == "validation");
+    ASSERT_TRUE(nlohmann::json::parse(jsonl.back())["improved"] == true);
+
+    std::remove(csv_filename.c_str());
+    std::remove(jsonl_filename.c_str());
+
+    std::cout << "✓ Metrics reporter outputs passed" << std::endl;
+    return true;
+}
+
+bool test_reporter_drops_progress() {
+    std::cout << "Testing metrics reporter under load..." << std::endl;
+
+    // A tiny ring and a slow reporter: progress gets dropped, epoch results never do
+    std::ostringstream console;
+    ANN::MetricsReporter reporter(&console, "", "", 4, std::chrono::milliseconds(20));
+    int accepted = 0;
+    for (int i = 0; i < 1000; ++i) {
+        accepted += reporter.progress(i, 1000, 10.0) ? 1 : 0;
+    }
+    ANN::EpochStats stats;
+    stats.epoch = 1;
+    for (int i = 0; i < 10; ++i) {
+        reporter.epoch(stats);
+    }
+    reporter.close();
+
+    ASSERT_TRUE(accepted >= 4);
+    ASSERT_TRUE(reporter.dropped() == static_cast<uint64_t>(1000 - accepted));
+
+    size_t completed = 0;
+    const std::string text = console.str();
+    for (size_t at = text.find("completed"); at != std::string::npos; at = text.find("completed", at + 1)) {
+        completed++;
+    }
+    ASSERT_TRUE(completed == 10);
+
+    // Closed, nothing more is accepted
+    ASSERT_TRUE(!reporter.progress(1, 1, 1.0));
+
+    std::cout << "✓ Metrics reporter under load passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Metrics Reporter Tests" << std::endl;
+    std::cout << "==============================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_ring_single_thread();
+    all_passed &= test_ring_concurrent();
+    all_passed &= test_reporter_outputs();
+    all_passed &= test_reporter_drops_progress();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
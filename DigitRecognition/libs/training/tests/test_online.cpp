@@ -0,0 +1,199 @@
+#include "../online.hpp"
+#include "test_fixtures.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "ASSERTION FAILED: " << #actual << " = " << (actual) \
+                      << ", expected " << (expected) << " (tolerance " << (tolerance) << ")" << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+static ANN::Config make_config() {
+    ANN::Config config = make_base_config(10);
+    config.online.replay_capacity = 200;
+    config.online.replay_ratio = 2;
+    config.online.learning_rate = 0.5;
+    config.online.publish_interval = 0;
+    return config;
+}
+
+bool test_replay_buffer() {
+    std::cout << "Testing the reservoir sampled replay buffer..." << std::endl;
+
+    ANN::ReplayBuffer buffer(100, 7);
+    ASSERT_TRUE(buffer.empty());
+    ANN::TrainingInstance instance;
+    for (int i = 0; i < 10000; ++i) {
+        instance.label = i;
+        buffer.add(instance);
+    }
+    ASSERT_TRUE(buffer.size() == 100 && buffer.seen() == 10000);
+
+    // A uniform sample of the whole stream, not just its start or end
+    double mean = 0.0;
+    int early = 0;
+    for (const auto& kept : buffer.instances()) {
+        mean += kept.label / 100.0;
+        early += kept.label < 5000;
+    }
+    ASSERT_NEAR(mean, 5000.0, 1000.0);
+    ASSERT_TRUE(early > 25 && early < 75);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(buffer.sample().label < 10000);
+    }
+
+    ANN::ReplayBuffer none(0, 7);
+    none.add(instance);
+    ASSERT_TRUE(none.empty() && none.seen() == 1);
+
+    std::cout << "✓ Replay buffer passed" << std::endl;
+    return true;
+}
+
+bool test_incremental_update() {
+    std::cout << "Testing learning new samples without forgetting..." << std::endl;
+
+    ANN::Config config = make_config();
+    auto original = make_data_set(200, 0, 3);
+    ANN::Network network = make_network(31);
+    ANN::Trainer(network, config.training, 1).run(original);
+
+    ANN::OnlineLearner learner(network, config.online, 5);
+    ASSERT_TRUE(learner.version() == 0);
+    ASSERT_TRUE(accuracy(learner, original) > 95.0);
+    learner.remember(original);
+    ASSERT_TRUE(learner.replay_size() == 200);
+
+    // A class the network has never seen arrives in daily batches of corrections
+    auto corrections = make_data_set(20, 3, 1);
+    for (int day = 0; day < 10; ++day) {
+        auto stats = learner.update(corrections);
+        ASSERT_TRUE(stats.samples == 20 && stats.replayed == 40 && stats.publishes == 1);
+        ASSERT_TRUE(stats.version == static_cast<uint64_t>(day + 1));
+    }
+    const double new_accuracy = accuracy(learner, corrections);
+    const double old_accuracy = accuracy(learner, original);
+    std::cout << "  new class " << new_accuracy << "%, original classes " << old_accuracy << "%" << std::endl;
+    ASSERT_TRUE(new_accuracy > 95.0);
+    ASSERT_TRUE(old_accuracy > 90.0);
+
+    // Publishing every 5 samples
+    config.online.publish_interval = 5;
+    ANN::OnlineLearner frequent(network, config.online, 5);
+    auto stats = frequent.update(make_data_set(12, 3, 1));
+    ASSERT_TRUE(stats.publishes == 3 && frequent.version() == 3);
+
+    std::cout << "✓ Incremental update passed" << std::endl;
+    return true;
+}
+
+bool test_readers_during_update() {
+    std::cout << "Testing predictions while the learner trains..." << std::endl;
+
+    ANN::Config config = make_config();
+    config.online.publish_interval = 3;
+    auto original = make_data_set(100, 0, 3);
+    ANN::Network network = make_network(41);
+    ANN::OnlineLearner learner(network, config.online, 9);
+    learner.remember(original);
+
+    // A snapshot taken now is untouched by the updates that follow
+    auto before = learner.snapshot();
+    std::vector<double> before_parameters(before->parameters().begin(), before->parameters().end());
+
+    std::atomic<bool> done{false};
+    std::atomic<int> predictions{0};
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&, r] {
+            uint64_t last_version = 0;
+            while (!done.load()) {
+                const uint64_t version = learner.version();
+                const int label = learner.predict_label(original.get_instances()[r].input_data);
+                if (label < 0 || label >= 10 || version < last_version) {
+                    failed = true;
+                }
+                last_version = version;
+                predictions++;
+            }
+        });
+    }
+
+    auto corrections = make_data_set(30, 3, 1);
+    for (int day = 0; day < 5; ++day) {
+        learner.update(corrections);
+    }
+    // Keep the writer going until every reader has predicted a good few times
+    while (predictions.load() < 300) {
+        learner.update(corrections);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    ASSERT_TRUE(!failed.load());
+    ASSERT_TRUE(learner.version() >= 50);
+    ASSERT_TRUE(std::ranges::equal(before->parameters(), before_parameters));
+    ASSERT_TRUE(!std::ranges::equal(learner.snapshot()->parameters(), before_parameters));
+
+    std::cout << "✓ Readers during update passed" << std::endl;
+    return true;
+}
+
+bool test_source_instrumentation_untouched() {
+    std::cout << "Testing updates leave the source network's profiler alone..." << std::endl;
+
+    ANN::Config config = make_config();
+    ANN::Network network = make_network(43);
+    ANN::Profiling::Profiler profiler;
+    network.set_profiler(&profiler);
+
+    ANN::OnlineLearner learner(network, config.online, 5);
+    learner.update(make_data_set(20));
+    learner.predict_label(make_data_set(1).get_instances()[0].input_data);
+
+    for (size_t phase = 0; phase < ANN::Profiling::PHASE_COUNT; ++phase) {
+        ASSERT_TRUE(profiler.milliseconds(static_cast<ANN::Profiling::Phase>(phase)) == 0.0);
+    }
+
+    std::cout << "✓ Source instrumentation passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Online Learning Tests" << std::endl;
+    std::cout << "=============================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_replay_buffer();
+    all_passed &= test_incremental_update();
+    all_passed &= test_readers_during_update();
+    all_passed &= test_source_instrumentation_untouched();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
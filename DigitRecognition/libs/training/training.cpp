@@ -1,6 +1,316 @@
 #include "training.hpp"
+#include "../images/images.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 
 namespace ANN {
-    // Training library implementation placeholder
-    // TODO: Add training functionality
-}
\ No newline at end of file
+
+TrainingSet load_training_set(const std::string& directory, bool normalize, Profiling::Profiler* profiler, unsigned int threads) {
+    // Gather the file list and labels first so the decoding can be shared out,
+    // files are named <label>_<anything>.png
+    std::vector<std::filesystem::path> files;
+    std::vector<int> labels;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".png") {
+            continue;
+        }
+        const std::string stem = entry.path().stem().string();
+        const std::string prefix = stem.substr(0, stem.find('_'));
+        int label = 0;
+        auto [parsed, error] = std::from_chars(prefix.data(), prefix.data() + prefix.size(), label);
+        if (prefix.empty() || error != std::errc() || parsed != prefix.data() + prefix.size()) {
+            std::cerr << "Skipping image, file name does not start with a label: " << entry.path().string() << std::endl;
+            continue;
+        }
+        files.push_back(entry.path());
+        labels.push_back(label);
+    }
+
+    // SDL must start on the calling thread, not on whichever worker decodes first
+    init_image_decoding();
+
+    std::vector<TrainingInstance> instances(files.size());
+    std::atomic<size_t> next_file{0};
+    std::mutex profiler_mutex;
+
+    auto worker = [&]() {
+        Profiling::Profiler local_profiler;
+        Profiling::Profiler* timing = profiler ? &local_profiler : nullptr;
+
+        for (size_t i = next_file++; i < files.size(); i = next_file++) {
+            std::string filename = files[i].filename().string();
+
+            std::vector<unsigned char> file_bytes;
+            {
+                Profiling::ScopedTimer timer(timing, Profiling::Phase::DataLoad);
+                file_bytes = read_file_bytes(files[i].string());
+            }
+
+            std::vector<double> image_data;
+            {
+                Profiling::ScopedTimer timer(timing, Profiling::Phase::Decode);
+                image_data = decode_image(file_bytes);
+            }
+
+            if (normalize && !image_data.empty()) {
+                Profiling::ScopedTimer timer(timing, Profiling::Phase::Normalise);
+                normalise_image(image_data, 255);
+            }
+
+            instances[i] = {std::move(image_data), labels[i], filename};
+            local_profiler.add_samples(1);
+        }
+
+        if (profiler) {
+            std::lock_guard<std::mutex> lock(profiler_mutex);
+            profiler->merge(local_profiler);
+        }
+    };
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (threads == 1 || files.size() < 2) {
+        worker();
+    } else {
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; ++t) {
+            workers.emplace_back(worker);
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+
+    TrainingSet training_set;
+    for (auto& instance : instances) {
+        training_set.add_instance(std::move(instance));
+    }
+    return training_set;
+}
+
+std::pair<TrainingSet, TrainingSet> split_training_set(const TrainingSet& data_set, double validation_fraction, unsigned int seed) {
+    const auto& instances = data_set.get_instances();
+
+    std::vector<size_t> order(instances.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::mt19937 rng(seed);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    validation_fraction = std::clamp(validation_fraction, 0.0, 1.0);
+    const size_t validation_count = static_cast<size_t>(instances.size() * validation_fraction);
+
+    std::pair<TrainingSet, TrainingSet> split;
+    for (size_t i = 0; i < order.size(); ++i) {
+        auto& target = i < validation_count ? split.second : split.first;
+        target.add_instance(instances[order[i]]);
+    }
+    return split;
+}
+
+TrainingSet shard_training_set(const TrainingSet& data_set, size_t shard_index, size_t shard_count) {
+    const auto& instances = data_set.get_instances();
+
+    TrainingSet shard;
+    for (size_t i = shard_index; i < instances.size(); i += std::max<size_t>(1, shard_count)) {
+        shard.add_instance(instances[i]);
+    }
+    return shard;
+}
+
+Network make_network(const Config& config) {
+    Network network(config.network.layers, config.network.weight_init, config.training.learning_rate, config.network.activation);
+    network.set_huge_pages(config.network.huge_pages);
+    network.set_fused_update(config.training.fused_update);
+    network.set_sparse_input_threshold(config.network.sparse_input_threshold);
+    network.set_activation_kernel(*parse_activation_kernel(config.network.activation_kernel));
+    return network;
+}
+
+Trainer::Trainer(Network& network, const Config::TrainingConfig& config, unsigned int seed)
+    : network_(network)
+    , config_(config)
+    , rng_(seed)
+{
+}
+
+void Trainer::set_teacher(const TeacherCache* teacher) {
+    if (teacher && teacher->outputs() != network_.output_size()) {
+        throw std::runtime_error("Teacher network has " + std::to_string(teacher->outputs()) +
+                                 " outputs, the student has " + std::to_string(network_.output_size()));
+    }
+    teacher_ = teacher;
+}
+
+void Trainer::restore(const TrainingState& state) {
+    std::istringstream rng_state(state.rng);
+    rng_state >> rng_;
+    if (!rng_state) {
+        throw std::runtime_error("Corrupt shuffle generator state in training state");
+    }
+    order_ = state.order;
+    resume_ = state;
+}
+
+std::vector<EpochStats> Trainer::run(const TrainingSet& training_set) {
+    std::vector<EpochStats> history;
+    history.reserve(config_.epochs);
+
+    for (int epoch = resume_ ? resume_->epoch : 0; epoch < config_.epochs; ++epoch) {
+        history.push_back(run_epoch(training_set, epoch));
+    }
+    return history;
+}
+
+EpochStats Trainer::run_epoch(const TrainingSet& training_set, int epoch) {
+    const auto& instances = training_set.get_instances();
+
+    if (profiler_) {
+        profiler_->reset();
+    }
+    auto epoch_start = std::chrono::steady_clock::now();
+
+    // A restored state part way through this epoch already holds its shuffled order
+    std::optional<TrainingState> resume = std::exchange(resume_, std::nullopt);
+    if (resume && resume->epoch != epoch) {
+        resume.reset();
+    }
+    if (resume && !resume->order.empty() && resume->order.size() != instances.size()) {
+        throw std::runtime_error("Training state is for a set of " + std::to_string(resume->order.size()) +
+                                 " samples, not " + std::to_string(instances.size()));
+    }
+    const size_t first = resume ? std::min(resume->position, instances.size()) : 0;
+
+    if (order_.size() != instances.size()) {
+        order_.resize(instances.size());
+        std::iota(order_.begin(), order_.end(), size_t(0));
+    }
+
+    // Shuffle the training data to prevent catastrophic forgetting
+    if (config_.shuffle && first == 0) {
+        Profiling::ScopedTimer timer(profiler_, Profiling::Phase::Shuffle);
+        std::shuffle(order_.begin(), order_.end(), rng_);
+    }
+
+    EpochStats stats;
+    stats.epoch = epoch + 1;
+    int correct_predictions = 0;  // Track training accuracy
+    if (first > 0) {
+        stats.samples = static_cast<int>(first);
+        stats.total_loss = resume->total_loss;
+        correct_predictions = resume->correct;
+    }
+
+    auto state = [&](int state_epoch, size_t position) {
+        TrainingState training_state;
+        training_state.epoch = state_epoch;
+        training_state.position = position;
+        training_state.learning_rate = network_.learning_rate();
+        if (position > 0) {
+            training_state.total_loss = stats.total_loss;
+            training_state.correct = correct_predictions;
+        }
+        std::ostringstream rng_state;
+        rng_state << rng_;
+        training_state.rng = rng_state.str();
+        training_state.order = order_;
+        training_state.augment_seed = augmenter_ ? augmenter_->seed() : 0;
+        return training_state;
+    };
+
+    const LearningRateScheduler scheduler(config_.learning_rate, config_.epochs, instances.size());
+    stats.learning_rate = scheduler.rate(epoch);
+    network_.set_learning_rate(stats.learning_rate);
+
+    if (teacher_ && teacher_->size() != instances.size()) {
+        throw std::runtime_error("Teacher outputs were cached for a different training set");
+    }
+    std::vector<double> target;
+
+    auto train_sample = [&](const std::vector<double>& input, int label, size_t index) {
+        // The step reports the prediction from its own forward pass, before the update
+        if (scheduler.per_iteration()) {
+            network_.set_learning_rate(scheduler.rate(epoch, stats.samples));
+        }
+
+        TrainStepResult step;
+        if (teacher_) {
+            teacher_->distillation_targets(index, label, config_.distillation.temperature, config_.distillation.alpha, target);
+            step = network_.train(input, target);
+        } else {
+            step = network_.train(input, label);
+        }
+        stats.total_loss += step.loss;
+
+        if (step.predicted_label == label) {
+            correct_predictions++;
+        }
+
+        stats.samples++;
+
+        if (progress_callback_ && stats.samples % progress_interval_ == 0) {
+            double current_accuracy = (double)correct_predictions / stats.samples * 100.0;
+            progress_callback_(stats.samples, instances.size(), current_accuracy);
+        }
+
+        if (checkpoint_callback_ && checkpoint_interval_ > 0 && stats.samples % checkpoint_interval_ == 0
+            && static_cast<size_t>(stats.samples) < instances.size()) {
+            checkpoint_callback_(state(epoch, stats.samples));
+        }
+    };
+
+    if (augmenter_) {
+        // Batches are augmented ahead on the pipeline's threads, only waits count as augment time
+        AugmentationPipeline pipeline(training_set, order_, *augmenter_, epoch, first);
+        for (;;) {
+            const AugmentedBatch* batch;
+            {
+                Profiling::ScopedTimer timer(profiler_, Profiling::Phase::Augment);
+                batch = pipeline.next();
+            }
+            if (!batch) {
+                break;
+            }
+            for (size_t i = 0; i < batch->inputs.size(); ++i) {
+                train_sample(batch->inputs[i], batch->labels[i], batch->indices[i]);
+            }
+        }
+    } else {
+        for (size_t i = first; i < order_.size(); ++i) {
+            const size_t index = order_[i];
+            train_sample(instances[index].input_data, instances[index].label, index);
+        }
+    }
+
+    // Calculate statistics for this epoch
+    if (stats.samples > 0) {
+        stats.avg_loss = stats.total_loss / stats.samples;
+        stats.accuracy = (double)correct_predictions / stats.samples * 100.0;
+    }
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - epoch_start).count();
+
+    if (profiler_) {
+        profiler_->add_samples(stats.samples);
+    }
+    if (epoch_callback_) {
+        epoch_callback_(stats);
+    }
+    if (checkpoint_callback_) {
+        checkpoint_callback_(state(epoch + 1, 0));
+    }
+
+    return stats;
+}
+
+}
@@ -2,6 +2,16 @@
 
 #include <vector>
 #include <string>
+#include <functional>
+#include <optional>
+#include <random>
+#include <utility>
+
+#include "../networks/networks.hpp"
+#include "../config/config.hpp"
+#include "../profiling/profiler.hpp"
+#include "augmentation.hpp"
+#include "distillation.hpp"
 
 
 namespace ANN {
@@ -22,6 +32,10 @@ namespace ANN {
             instances_.push_back(instance);
         }
 
+        void add_instance(TrainingInstance&& instance) {
+            instances_.push_back(std::move(instance));
+        }
+
         const std::vector<TrainingInstance>& get_instances() const {
             return instances_;
         }
@@ -30,5 +44,139 @@ namespace ANN {
         std::vector<TrainingInstance> instances_;
     };
 
-    
-}
\ No newline at end of file
+    //
+    // Load every png in a directory, the label is the filename prefix before the first '_'
+    // Files are decoded by threads workers (0 = one per hardware thread) in directory order.
+    // Time spent reading, decoding and normalising is accounted to the profiler if given,
+    // summed over the workers.
+    //
+    TrainingSet load_training_set(const std::string& directory, bool normalize,
+                                  Profiling::Profiler* profiler = nullptr, unsigned int threads = 1);
+
+    //
+    // Hold back a random fraction of a data set, returns {training, validation}.
+    // The same seed always gives the same split.
+    //
+    std::pair<TrainingSet, TrainingSet> split_training_set(const TrainingSet& data_set, double validation_fraction,
+                                                           unsigned int seed = 0);
+
+    //
+    // Every shard_count-th instance starting at shard_index, so shards are disjoint, cover the set
+    // and keep the directory's class mix.
+    //
+    TrainingSet shard_training_set(const TrainingSet& data_set, size_t shard_index, size_t shard_count);
+
+    //
+    // Network as configured: layers, activation and its kernel, weight initialisation, huge pages,
+    // fused update and sparse input threshold. Normal runs, sweep runs and the distributed server
+    // and workers all build theirs here.
+    //
+    Network make_network(const Config& config);
+
+
+    //
+    // Statistics gathered over one pass of the training set
+    //
+    struct EpochStats {
+        int epoch = 0;              // 1 based
+        double total_loss = 0.0;
+        double avg_loss = 0.0;
+        double accuracy = 0.0;      // training accuracy, percent
+        int samples = 0;
+        double milliseconds = 0.0;  // wall time for the epoch
+        double learning_rate = 0.0; // rate at the start of the epoch
+    };
+
+
+    //
+    // Where a Trainer is in a run, enough to carry on exactly where it left off: the epoch and
+    // the samples of it already trained, the shuffle generator and sample order, and the epoch's
+    // running totals. Plain SGD keeps no other optimizer state, the learning rate follows from
+    // the schedule and the position.
+    //
+    struct TrainingState {
+        int epoch = 0;              // 0 based epoch to carry on with
+        size_t position = 0;        // samples of that epoch already trained, 0 = not started
+        double learning_rate = 0.0; // rate of the last step, for reference
+        double total_loss = 0.0;    // loss and correct predictions of the epoch so far
+        int correct = 0;
+        std::string rng;            // shuffle generator state as written by operator<<
+        std::vector<size_t> order;  // sample order, the epoch's shuffle once position > 0
+        uint64_t augment_seed = 0;  // seed of the augmenter in use, 0 = none
+    };
+
+
+    //
+    // Runs the epoch loop for a network over a training set.
+    // Sets the network's learning rate from config.learning_rate at each epoch, or each sample
+    // when the schedule updates per iteration.
+    // The training set is only read, shuffling permutes an index, so one decoded
+    // data set can be shared between several trainers running on different threads.
+    //
+    class Trainer {
+    public:
+        using ProgressCallback = std::function<void(int samples_processed, size_t total, double accuracy)>;
+        using EpochCallback = std::function<void(const EpochStats& stats)>;
+        using CheckpointCallback = std::function<void(const TrainingState& state)>;
+
+        Trainer(Network& network, const Config::TrainingConfig& config, unsigned int seed = std::random_device{}());
+
+        void set_profiler(Profiling::Profiler* profiler) { profiler_ = profiler; }
+
+        // Train on augmented copies made on the augmenter's threads, nullptr trains on the set as is
+        void set_augmenter(const Augmenter* augmenter) { augmenter_ = augmenter; }
+
+        // Distil from a teacher's cached outputs for the training set run() is given, using
+        // config.distillation's temperature and alpha. nullptr trains on the labels alone.
+        // Throws if the teacher's output count differs from the network's.
+        void set_teacher(const TeacherCache* teacher);
+
+        // Called every interval samples during an epoch
+        void on_progress(ProgressCallback callback, int interval = 100) {
+            progress_callback_ = std::move(callback);
+            progress_interval_ = interval;
+        }
+
+        // Called after each epoch with that epoch's statistics
+        void on_epoch_end(EpochCallback callback) {
+            epoch_callback_ = std::move(callback);
+        }
+
+        // Called with the state to resume from at the end of every epoch and, if interval is
+        // positive, every interval samples within an epoch. The network is as of that state.
+        void on_checkpoint(CheckpointCallback callback, int interval = 0) {
+            checkpoint_callback_ = std::move(callback);
+            checkpoint_interval_ = interval;
+        }
+
+        // Carry on from a saved state: the next run_epoch for state.epoch starts at state.position.
+        // Restore the network's parameters separately.
+        void restore(const TrainingState& state);
+
+        // Train for config.epochs over the training set
+        std::vector<EpochStats> run(const TrainingSet& training_set);
+
+        // One pass over the training set, epoch is 0 based
+        EpochStats run_epoch(const TrainingSet& training_set, int epoch);
+
+    private:
+        Network& network_;
+        Config::TrainingConfig config_;
+        std::mt19937 rng_;
+        std::vector<size_t> order_;
+
+        Profiling::Profiler* profiler_ = nullptr;
+        const Augmenter* augmenter_ = nullptr;
+        const TeacherCache* teacher_ = nullptr;
+        ProgressCallback progress_callback_;
+        int progress_interval_ = 100;
+        EpochCallback epoch_callback_;
+        CheckpointCallback checkpoint_callback_;
+        int checkpoint_interval_ = 0;
+
+        // Set by restore() until the epoch it belongs to is run
+        std::optional<TrainingState> resume_;
+    };
+
+
+}
@@ -0,0 +1,64 @@
+#include "snapshots.hpp"
+#include "visualization.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace ANN {
+namespace Visualization {
+
+AsyncWeightSnapshots::AsyncWeightSnapshots(size_t max_pending, Writer writer)
+    : max_pending_(std::max<size_t>(1, max_pending))
+    , writer_(std::move(writer))
+    , worker_([this](Snapshot& snapshot) { write(snapshot); })
+{
+}
+
+AsyncWeightSnapshots::~AsyncWeightSnapshots() = default;
+
+bool AsyncWeightSnapshots::submit(const Layer& layer, const std::string& filename,
+                                  int grid_width, int grid_height, int scale) {
+    if (worker_.queued() >= max_pending_) {
+        dropped_++;
+        return false;
+    }
+
+    worker_.push(Snapshot{
+        std::vector<double>(layer.weights_.begin(), layer.weights_.end()),
+        static_cast<int>(layer.inputs_.size()),
+        static_cast<int>(layer.outputs_.size()),
+        filename, grid_width, grid_height, scale
+    });
+    return true;
+}
+
+void AsyncWeightSnapshots::wait() {
+    worker_.wait();
+}
+
+size_t AsyncWeightSnapshots::written() const {
+    return written_;
+}
+
+size_t AsyncWeightSnapshots::dropped() const {
+    return dropped_;
+}
+
+void AsyncWeightSnapshots::write(Snapshot& snapshot) {
+    if (writer_) {
+        if (writer_(snapshot)) {
+            written_++;
+        }
+        return;
+    }
+
+    // Quiet, the training thread owns the console
+    if (save_weights_as_image(snapshot.weights, snapshot.input_size, snapshot.output_size,
+                              snapshot.filename, snapshot.grid_width, snapshot.grid_height,
+                              snapshot.scale, false)) {
+        written_++;
+    }
+}
+
+} // namespace Visualization
+} // namespace ANN
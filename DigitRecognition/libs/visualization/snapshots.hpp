@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../layers/layers.h"
+#include "../threading/background_worker.hpp"
+
+namespace ANN {
+namespace Visualization {
+
+    //
+    // Writes weight images on a background thread so training never waits on SDL or the PNG encoder.
+    // submit() only copies the layer's weights, at most max_pending copies wait to be encoded and
+    // further snapshots are dropped (and counted) rather than stalling the caller.
+    //
+    class AsyncWeightSnapshots {
+    public:
+        struct Snapshot {
+            std::vector<double> weights;
+            int input_size;
+            int output_size;
+            std::string filename;
+            int grid_width;
+            int grid_height;
+            int scale;
+        };
+
+        // Writes one snapshot, true if it was saved. The default is save_weights_as_image.
+        using Writer = std::function<bool(const Snapshot& snapshot)>;
+
+        explicit AsyncWeightSnapshots(size_t max_pending = 4, Writer writer = {});
+        ~AsyncWeightSnapshots();  // writes whatever is still queued
+
+        AsyncWeightSnapshots(const AsyncWeightSnapshots&) = delete;
+        AsyncWeightSnapshots& operator=(const AsyncWeightSnapshots&) = delete;
+
+        // Queue the layer's weights as they are now, one grid_width x grid_height cell per neuron.
+        // Returns false if the queue was full and the snapshot was dropped.
+        bool submit(const Layer& layer, const std::string& filename,
+                    int grid_width = 28, int grid_height = 28, int scale = 2);
+
+        // Block until every queued snapshot has been written
+        void wait();
+
+        size_t written() const;
+        size_t dropped() const;
+
+    private:
+        void write(Snapshot& snapshot);
+
+        size_t max_pending_;
+        Writer writer_;
+        std::atomic<size_t> written_{0};
+        std::atomic<size_t> dropped_{0};
+
+        BackgroundWorker<Snapshot> worker_;
+    };
+
+} // namespace Visualization
+} // namespace ANN
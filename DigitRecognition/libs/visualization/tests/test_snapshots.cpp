@@ -0,0 +1,123 @@
+#include "../snapshots.hpp"
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <latch>
+#include <string>
+#include <vector>
+
+// Simple test framework macros
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "ASSERTION FAILED: " << #condition << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+using ANN::Visualization::AsyncWeightSnapshots;
+
+bool test_full_queue_drops() {
+    std::cout << "Testing snapshots are dropped while the queue is full..." << std::endl;
+
+    ANN::Layer layer(16, 4);
+    std::promise<void> started;
+    std::latch release(1);
+    std::atomic<int> calls{0};
+    std::vector<std::string> filenames;
+
+    // The first write holds the worker until released, so later submits pile up in the queue
+    AsyncWeightSnapshots snapshots(2, [&](const AsyncWeightSnapshots::Snapshot& snapshot) {
+        if (calls++ == 0) {
+            started.set_value();
+            release.wait();
+        }
+        filenames.push_back(snapshot.filename);
+        return true;
+    });
+
+    ASSERT_TRUE(snapshots.submit(layer, "epoch_1.png", 4, 4, 1));
+    started.get_future().wait();
+    ASSERT_TRUE(snapshots.submit(layer, "epoch_2.png", 4, 4, 1));
+    ASSERT_TRUE(snapshots.submit(layer, "epoch_3.png", 4, 4, 1));
+    ASSERT_TRUE(!snapshots.submit(layer, "epoch_4.png", 4, 4, 1));
+    ASSERT_TRUE(!snapshots.submit(layer, "epoch_5.png", 4, 4, 1));
+    ASSERT_TRUE(snapshots.dropped() == 2);
+
+    release.count_down();
+    snapshots.wait();
+    ASSERT_TRUE(snapshots.written() == 3);
+    ASSERT_TRUE((filenames == std::vector<std::string>{"epoch_1.png", "epoch_2.png", "epoch_3.png"}));
+
+    // Room again once the queue has drained
+    ASSERT_TRUE(snapshots.submit(layer, "epoch_6.png", 4, 4, 1));
+    snapshots.wait();
+    ASSERT_TRUE(snapshots.written() == 4 && snapshots.dropped() == 2);
+
+    std::cout << "✓ Full queue tests passed" << std::endl;
+    return true;
+}
+
+bool test_written_counts_successes() {
+    std::cout << "Testing written() after wait()..." << std::endl;
+
+    ANN::Layer layer(16, 4);
+    layer.weights_[0] = 0.25;
+    std::atomic<int> calls{0};
+
+    // Every other write fails, and the copy is the weights as they were at submit()
+    AsyncWeightSnapshots snapshots(8, [&](const AsyncWeightSnapshots::Snapshot& snapshot) {
+        bool copied = snapshot.weights.size() == 64 && snapshot.weights[0] == 0.25
+                   && snapshot.input_size == 16 && snapshot.output_size == 4;
+        return copied && calls++ % 2 == 0;
+    });
+
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_TRUE(snapshots.submit(layer, "snapshot.png", 4, 4, 1));
+    }
+    layer.weights_[0] = -1.0;
+    snapshots.wait();
+    ASSERT_TRUE(calls == 6);
+    ASSERT_TRUE(snapshots.written() == 3);
+    ASSERT_TRUE(snapshots.dropped() == 0);
+
+    std::cout << "✓ Written count tests passed" << std::endl;
+    return true;
+}
+
+bool test_default_writer_saves_png() {
+    std::cout << "Testing the default writer saves an image..." << std::endl;
+
+    ANN::Layer layer(16, 4);
+    const std::string filename = "test_snapshots_weights.png";
+    std::remove(filename.c_str());
+
+    AsyncWeightSnapshots snapshots;
+    ASSERT_TRUE(snapshots.submit(layer, filename, 4, 4, 1));
+    snapshots.wait();
+    ASSERT_TRUE(snapshots.written() == 1);
+    ASSERT_TRUE(std::filesystem::exists(filename));
+    std::remove(filename.c_str());
+
+    std::cout << "✓ Default writer tests passed" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "Running Weight Snapshot Tests" << std::endl;
+    std::cout << "=============================" << std::endl;
+    bool all_passed = true;
+    all_passed &= test_full_queue_drops();
+    all_passed &= test_written_counts_successes();
+    all_passed &= test_default_writer_saves_png();
+    std::cout << std::endl;
+    if (all_passed) {
+        std::cout << "🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
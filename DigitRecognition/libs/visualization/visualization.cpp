@@ -12,14 +12,15 @@
 namespace ANN {
 namespace Visualization {
 
-void save_weights_as_image(
-    const std::vector<double>& weights,
+bool save_weights_as_image(
+    std::span<const double> weights,
     int input_size,
     int output_size,
     const std::string& filename,
     int grid_width,
     int grid_height,
-    int scale
+    int scale,
+    bool announce
 ) {
 #if HAS_SDL_IMAGE
     // Calculate how many neurons we can fit per row
@@ -42,7 +43,7 @@ void save_weights_as_image(
     
     if (!surface) {
         std::cerr << "Failed to create SDL surface: " << SDL_GetError() << std::endl;
-        return;
+        return false;
     }
     
     // Fill with gray background
@@ -110,15 +111,18 @@ void save_weights_as_image(
     }
     
     // Save as PNG
-    if (IMG_SavePNG(surface, filename.c_str()) != 0) {
+    bool saved = IMG_SavePNG(surface, filename.c_str()) == 0;
+    if (!saved) {
         std::cerr << "Failed to save image: " << IMG_GetError() << std::endl;
-    } else {
+    } else if (announce) {
         std::cout << "Saved weight visualization: " << filename << std::endl;
     }
     
     SDL_FreeSurface(surface);
+    return saved;
 #else
     std::cerr << "SDL2_image not available - cannot save weight visualization" << std::endl;
+    return false;
 #endif
 }
 
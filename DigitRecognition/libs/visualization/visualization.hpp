@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <vector>
 #include <string>
 #include "../layers/layers.h"
@@ -10,14 +11,16 @@ namespace Visualization {
     // Save layer weights as a grid image
     // For a layer with input_size x output_size, creates a visualization
     // where each output neuron's weights are shown as a row/grid
-    void save_weights_as_image(
-        const std::vector<double>& weights,
+    // Returns false if the image could not be written
+    bool save_weights_as_image(
+        std::span<const double> weights,
         int input_size,
         int output_size,
         const std::string& filename,
         int grid_width = 28,  // For MNIST, typically 28x28
         int grid_height = 28,
-        int scale = 2  // Scale factor for better visibility
+        int scale = 2,  // Scale factor for better visibility
+        bool announce = true  // Print the filename once saved
     );
 
     // Save all network layers' weights
@@ -9,6 +9,15 @@
 #include <atomic>
 #include <chrono>
 #include <fstream>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+#include <cstdio>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
 
 
 #include "libs/activations/activations.h"
@@ -16,19 +25,284 @@
 #include "libs/images/images.hpp"
 #include "libs/networks/networks.hpp"
 #include "libs/training/training.hpp"
+#include "libs/training/metrics.hpp"
+#include "libs/training/checkpoint.hpp"
+#include "libs/sweep/sweep.hpp"
+#include "libs/evaluation/evaluation.hpp"
+#include "libs/evaluation/validation.hpp"
 #include "libs/config/config.hpp"
+#include "libs/profiling/profiler.hpp"
+#include "libs/profiling/perf_counters.hpp"
+#include "libs/visualization/snapshots.hpp"
+#include "libs/distributed/parameter_server.hpp"
+#include "libs/distributed/worker.hpp"
+#include "libs/images/idx.hpp"
+#include "libs/infer/ann_infer.hpp"
 
 #include "utils.hpp"
 
 #include "version.h"
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
+// Milliseconds elapsed since start, used for the per stage wall time in the profile csv
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// Sweep mode, trains every configuration of a sweep file concurrently over one shared data set
+//
+static int run_sweep(const std::string& sweep_file) {
+    ANN::Sweep sweep;
+    try {
+        sweep = ANN::Sweep::from_file(sweep_file);
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading sweep: " << e.what() << std::endl;
+        return 1;
+    }
+    if (sweep.runs().empty()) {
+        std::cerr << "Sweep " << sweep_file << " has no runs, exiting." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Sweep of " << sweep.runs().size() << " runs on " << sweep.threads() << " threads" << std::endl;
+    for (const auto& run : sweep.runs()) {
+        std::cout << "\t" << run.name << std::endl;
+    }
+    std::cout << std::endl;
+
+    // Decode the data once, every run reads the same instances
+    const auto& data = sweep.runs().front().config.data;
+    std::cout << " Constructing Training and Test Sets " << std::endl;
+    ANN::TrainingSet training_set = ANN::load_training_set(data.train_path, data.normalize, nullptr, data.loader_threads);
+    ANN::TrainingSet test_set = ANN::load_training_set(data.test_path, data.normalize, nullptr, data.loader_threads);
+    std::cout << "Training set size " << training_set.get_instances().size()
+              << ", test set size " << test_set.get_instances().size() << std::endl;
+    std::cout << "Time " << Utils::Time::HumanReadableTimeNowMillis() << std::endl << std::endl;
+
+    auto results = sweep.run(training_set, test_set);
+
+    std::cout << "\nSweep completed!" << std::endl;
+    std::cout << "Time " << Utils::Time::HumanReadableTimeNowMillis() << std::endl;
+
+    if (ANN::Sweep::save_csv(results, sweep.output_file())) {
+        std::cout << "Sweep results saved to: " << sweep.output_file() << std::endl;
+    } else {
+        std::cerr << "Failed to save sweep results to: " << sweep.output_file() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+//
+// Parameter server mode, holds the weights while distributed.workers worker processes train them,
+// then tests and saves the result
+//
+static int run_parameter_server(const ANN::Config& config) {
+    ANN::Network network = ANN::make_network(config);
+    std::cout << "Weight seed " << network.weight_seed() << std::endl;
+
+    std::unique_ptr<ANN::Distributed::ParameterServer> server;
+    try {
+        server = std::make_unique<ANN::Distributed::ParameterServer>(network.parameters(), config.distributed);
+    } catch (const std::exception& e) {
+        std::cerr << "Error starting parameter server: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Parameter server listening on port " << server->port() << " for " << config.distributed.workers
+              << " worker(s), " << config.distributed.mode << " updates" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    server->run();
+    std::ranges::copy(server->parameters(), network.parameters().begin());
+
+    const auto stats = server->stats();
+    std::cout << "\nDistributed training completed in " << std::fixed << std::setprecision(1) << elapsed_ms(start) / 1000.0 << "s: "
+              << stats.updates << " updates from " << stats.samples << " samples, staleness mean "
+              << std::setprecision(2) << stats.mean_staleness << " max " << stats.max_staleness;
+    if (stats.blocked_pushes > 0) {
+        std::cout << ", " << stats.blocked_pushes << " pushes held at the bound";
+    }
+    std::cout << std::endl;
+
+    std::string run_tag = std::string(Version::GIT_COMMIT) + "_" + Utils::Time::HumanReadableTimeNowMillis();
+    for (auto& c : run_tag) {
+        if (c == ' ' || c == ':') c = '_';
+    }
+    std::string weights_filename = "DigitRecog_Distributed_" + run_tag + ".bin";
+    if (network.save(weights_filename)) {
+        std::cout << "Weights saved to: " << weights_filename << std::endl;
+    }
+
+    std::cout << "\nTesting network on test data..." << std::endl;
+    ANN::TrainingSet test_set = ANN::load_training_set(config.data.test_path, config.data.normalize, nullptr, config.data.loader_threads);
+    network.set_inference_mode(true);
+    network.set_inference_precision(*ANN::parse_precision(config.network.inference_precision));
+    auto evaluation = ANN::evaluate(network, test_set, config.evaluation.threads, config.evaluation.batch_size);
+    std::cout << "\n=== FINAL RESULTS ===\n";
+    evaluation.print(std::cout);
+    return 0;
+}
+
+//
+// Worker mode, trains this worker's shard of the training set against the parameter server
+//
+static int run_worker(ANN::Config config, const std::string& host) {
+    if (!host.empty()) {
+        config.distributed.host = host;
+    }
+    ANN::Network network = ANN::make_network(config);
+
+    std::cout << " Constructing Training Sets " << std::endl;
+    ANN::TrainingSet training_set = ANN::load_training_set(config.data.train_path, config.data.normalize, nullptr, config.data.loader_threads);
+
+    ANN::Distributed::DistributedTrainer trainer(network, config.training, config.distributed);
+    trainer.on_epoch_end([&](const ANN::EpochStats& stats) {
+        std::cout << "  Worker " << trainer.worker_index() << "/" << trainer.worker_count()
+                  << " epoch " << stats.epoch << " completed: " << stats.samples << " samples"
+                  << " | Loss: " << std::fixed << std::setprecision(6) << stats.avg_loss
+                  << " | Train Acc: " << std::fixed << std::setprecision(2) << stats.accuracy << "%"
+                  << " | LR: " << std::scientific << std::setprecision(3) << stats.learning_rate << std::defaultfloat << std::endl;
+    });
+
+    std::cout << "Connecting to parameter server " << config.distributed.host << ":" << config.distributed.port << std::endl;
+    try {
+        trainer.run(training_set);
+    } catch (const std::exception& e) {
+        std::cerr << "Distributed training failed: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Worker " << trainer.worker_index() << " done after " << trainer.pushes() << " pushes" << std::endl;
+    return 0;
+}
+
+//
+// Predict mode, labels images with a saved network and nothing else: no config, no banner,
+// and no SDL unless the input is a directory of image files. Messages go to stderr so the
+// csv can go to stdout.
+//
+//     DigitRecognition predict <weights.bin> <directory | images.idx3-ubyte | -> [output.csv | -] [--no-normalize]
+//
+// "-" as input reads raw images from stdin, input size bytes each, until it ends.
+//
+static int run_predict(int argc, char** argv) {
+    std::vector<std::string> args;
+    bool normalize = true;
+    for (int i = 2; i < argc; ++i) {
+        if (std::string(argv[i]) == "--no-normalize") {
+            normalize = false;
+        } else {
+            args.emplace_back(argv[i]);
+        }
+    }
+    if (args.size() < 2 || args.size() > 3) {
+        std::cerr << "Usage: DigitRecognition predict <weights.bin> <directory | images.idx3-ubyte | -> [output.csv | -] [--no-normalize]" << std::endl;
+        return 1;
+    }
+    const std::string& weights_file = args[0];
+    const std::string& input = args[1];
+    const std::string output = args.size() > 2 ? args[2] : "-";
+
+    ANN::Infer::Classifier classifier;
+    const ANN::Infer::Status status = classifier.load(weights_file.c_str());
+    if (status != ANN::Infer::Status::Ok) {
+        std::cerr << "Error loading " << weights_file << ": " << ANN::Infer::status_message(status) << std::endl;
+        return 1;
+    }
+    const double pixel_max = normalize ? 255.0 : 1.0;
+    classifier.set_pixel_max(pixel_max);
+
+    std::ofstream output_file;
+    if (output != "-") {
+        output_file.open(output);
+        if (!output_file.is_open()) {
+            std::cerr << "Error: could not open " << output << " for writing" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& csv = output == "-" ? std::cout : output_file;
+    csv << "index,source,label,score\n";
+
+    std::vector<double> outputs(classifier.output_size());
+    size_t index = 0;
+    auto write_row = [&](const std::string& source) {
+        const size_t label = std::max_element(outputs.begin(), outputs.end()) - outputs.begin();
+        csv << index++ << "," << source << "," << label << "," << outputs[label] << "\n";
+    };
+
+    const size_t input_size = classifier.input_size();
+    std::vector<uint8_t> pixels(input_size);
+
+    try {
+        if (input == "-") {
+#ifdef _WIN32
+            _setmode(_fileno(stdin), _O_BINARY);
+#endif
+            while (std::fread(pixels.data(), 1, input_size, stdin) == input_size) {
+                classifier.infer(pixels.data(), outputs.data());
+                write_row("stdin");
+            }
+        } else if (std::filesystem::is_directory(input)) {
+            // Image files only, load_image reports anything else on stdout where the csv may be going.
+            // Sorted so the index column is the same on every platform.
+            std::vector<std::filesystem::path> files;
+            for (const auto& entry : std::filesystem::directory_iterator(input)) {
+                const std::string extension = entry.path().extension().string();
+                if (entry.is_regular_file() && (extension == ".png" || extension == ".bmp" || extension == ".jpg" || extension == ".jpeg")) {
+                    files.push_back(entry.path());
+                }
+            }
+            std::sort(files.begin(), files.end());
+            for (const auto& file : files) {
+                std::vector<double> image = ANN::load_image(file.string());
+                if (image.size() != input_size) {
+                    std::cerr << "Skipping " << file.string() << ": " << image.size() << " pixels, the network takes "
+                              << input_size << std::endl;
+                    continue;
+                }
+                ANN::normalise_image(image, pixel_max);
+                classifier.infer(image.data(), outputs.data());
+                write_row(file.filename().string());
+            }
+        } else {
+            ANN::IdxImageReader reader(input);
+            if (reader.image_size() != input_size) {
+                std::cerr << "Error: " << input << " holds " << reader.rows() << "x" << reader.columns()
+                          << " images, the network takes " << input_size << " inputs" << std::endl;
+                return 1;
+            }
+            const std::string source = std::filesystem::path(input).filename().string();
+            while (reader.read(pixels.data())) {
+                classifier.infer(pixels.data(), outputs.data());
+                write_row(source);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    csv.flush();
+    std::cerr << "Predicted " << index << " images" << std::endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+
+    // DigitRecognition predict <weights.bin> <input> [output.csv], before anything else to start quickly
+    if (argc > 1 && std::string(argv[1]) == "predict") {
+        return run_predict(argc, argv);
+    }
 
     std::cout << "DigitRecognition v" << Version::VERSION_STRING << std::endl;
     std::cout << "Built: " << Version::BUILD_DATE << std::endl;
     std::cout << "Git: " << Version::GIT_COMMIT << std::endl << std::endl;
     std::cout << "Time: " << Utils::Time::HumanReadableTimeNowMillis() << std::endl << std::endl;
 
+    // DigitRecognition sweep [sweep.json]
+    if (argc > 1 && std::string(argv[1]) == "sweep") {
+        return run_sweep(argc > 2 ? argv[2] : "sweep.json");
+    }
+
     // Load configuration from config.json
     ANN::Config config;
     if (!config.validate()) {
@@ -40,46 +314,79 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
     config.print();
     std::cout << std::endl;
 
+    // DigitRecognition server
+    // DigitRecognition worker [host]
+    if (argc > 1 && std::string(argv[1]) == "server") {
+        return run_parameter_server(config);
+    }
+    if (argc > 1 && std::string(argv[1]) == "worker") {
+        return run_worker(config, argc > 2 ? argv[2] : "");
+    }
+
     std::cout << "Time " << Utils::Time::HumanReadableTimeNowMillis() << std::endl << std::endl;
 
     // Create network from configuration
-    ANN::WeightInitConfig weight_config;
-    weight_config.method = config.network.weight_init.method;
-    weight_config.range = config.network.weight_init.range;
-    ANN::Network network(config.network.layers, weight_config, config.training.learning_rate, config.network.activation);
+    ANN::Network network = ANN::make_network(config);
+    std::cout << "Weight seed " << network.weight_seed() << std::endl;
     ANN::TrainingSet training_set;
 
+    // Carry on from the latest checkpoint of a run that was stopped part way
+    std::optional<ANN::Checkpoint> resume_checkpoint;
+    if (config.training.checkpoint.enabled && config.training.checkpoint.resume) {
+        try {
+            resume_checkpoint = ANN::load_latest_checkpoint(config.training.checkpoint.directory);
+            if (resume_checkpoint) {
+                ANN::restore_checkpoint(*resume_checkpoint, network);
+                std::cout << "Resuming from checkpoint " << resume_checkpoint->sequence << ": epoch "
+                          << (resume_checkpoint->state.epoch + 1) << ", sample " << resume_checkpoint->state.position << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error restoring checkpoint: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Per phase timing, one row per stage/epoch goes to the profile csv
+    ANN::Profiling::Profiler profiler;
+    network.set_profiler(&profiler);
+
+    // Every output file of this run shares the same commit and timestamp tag
+    std::string run_tag = std::string(Version::GIT_COMMIT) + "_" + Utils::Time::HumanReadableTimeNowMillis();
+    // Replace spaces and colons in datetime for filename safety
+    for (auto& c : run_tag) {
+        if (c == ' ' || c == ':') c = '_';
+    }
+
+    std::unique_ptr<ANN::Profiling::ProfileCsvWriter> profile_file;
+    std::string profile_filename = "DigitRecog_Profile_" + run_tag + ".csv";
+    if (config.output.save_profile) {
+        profile_file = std::make_unique<ANN::Profiling::ProfileCsvWriter>(profile_filename);
+        std::cout << "Profiling enabled - saving to: " << profile_filename << std::endl;
+    }
+
     //
     // Load TRAINING data from train directory
     //
     
     std::cout << " Constructing Training Sets " << std::endl;
 
-    for (const auto& entry : std::filesystem::directory_iterator(config.data.train_path)) {
-        if (entry.is_regular_file()) {
-            if ( std::filesystem::path(entry).extension() == ".png" ) {
-                
-                std::string filename = std::filesystem::path(entry).filename().string();
-                int label = std::stoi(filename.substr(0, filename.find('_')));
-
-                std::vector<double> image_data = ANN::load_image(std::filesystem::path(entry).string());
-                
-                if (config.data.normalize && !image_data.empty()) {
-                    ANN::normalise_image(image_data, 255);
-                }
+    auto stage_start = std::chrono::steady_clock::now();
 
-                training_set.add_instance({image_data, label, filename});
+    training_set = ANN::load_training_set(config.data.train_path, config.data.normalize, &profiler, config.data.loader_threads);
 
-                // std::cout << "Added training instance: " << training_set.get_instances().size()   
-                //         << " file: " << filename 
-                //         << " label: " << label 
-                //         << " size: " << image_data.size() 
-                //         << "\n";
-            }
-        }
+    std::cout << "\nTraining set constructed from data, size " << training_set.get_instances().size() << std::endl;
+
+    if (profile_file) {
+        profile_file->write_row("load", 0, profiler, elapsed_ms(stage_start));
     }
 
-    std::cout << "\nTraining set constructed from data, size " << training_set.get_instances().size() << std::endl;
+    // Hold back part of the training data to watch for overfitting
+    ANN::TrainingSet validation_set;
+    if (config.training.validation_split > 0.0) {
+        std::tie(training_set, validation_set) = ANN::split_training_set(training_set, config.training.validation_split);
+        std::cout << "Validation split " << config.training.validation_split << ": " << training_set.get_instances().size()
+                  << " training, " << validation_set.get_instances().size() << " validation samples" << std::endl;
+    }
 
     // // Check data distribution
     // std::vector<int> label_counts(10, 0);
@@ -96,21 +403,13 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
     std::cout << "Training network..." << std::endl;
     std::cout << "Time " << Utils::Time::HumanReadableTimeNowMillis() << std::endl << std::endl;
 
-    // Shuffle the training data to prevent catastrophic forgetting
-    auto instances = training_set.get_instances();
-    std::random_device rd;
-    std::mt19937 g(rd());
-    
+    const auto& instances = training_set.get_instances();
+
     // Train for multiple epochs
     std::cout << "Training for " << config.training.epochs << " epochs on " << instances.size() << " samples..." << std::endl;
     
-    // Open loss tracking file if configured
-    std::ofstream loss_file;
-    std::string loss_filename = "DigitRecog_Loss_" + std::string(Version::GIT_COMMIT) + "_" + Utils::Time::HumanReadableTimeNowMillis() + ".csv";
-    // Replace spaces and colons in datetime for filename safety
-    for (auto& c : loss_filename) {
-        if (c == ' ' || c == ':') c = '_';
-    }
+    // Loss tracking file name, written by the metrics reporter if configured
+    std::string loss_filename = "DigitRecog_Loss_" + run_tag + ".csv";
     // Now generate txt_filename from loss_filename
     std::string txt_filename = loss_filename;
     size_t dot_pos = txt_filename.rfind('.');
@@ -119,122 +418,238 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
     } else {
         txt_filename += ".txt";
     }
+    // Optional per layer hardware counters around forward/backward/update
+    std::unique_ptr<ANN::Profiling::LayerPerfCounters> perf_counters;
+    if (config.output.perf_counters) {
+        perf_counters = std::make_unique<ANN::Profiling::LayerPerfCounters>(network.layer_count());
+        if (perf_counters->is_available()) {
+            network.set_perf_counters(perf_counters.get());
+            std::cout << "Hardware performance counters enabled" << std::endl;
+        } else {
+            std::cerr << "Hardware performance counters unavailable: " << perf_counters->error() << std::endl;
+        }
+    }
+
+    // Progress, epoch summaries and the loss CSV are written on the reporter's thread,
+    // training and validation only queue the numbers
+    std::unique_ptr<ANN::MetricsReporter> metrics;
+    std::string metrics_filename = "DigitRecog_Metrics_" + run_tag + ".jsonl";
+    try {
+        metrics = std::make_unique<ANN::MetricsReporter>(&std::cout, config.output.save_plots ? loss_filename : "",
+                                                         config.output.metrics_stream ? metrics_filename : "");
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
     if (config.output.save_plots) {
-        loss_file.open(loss_filename);
-        loss_file << "epoch,total_loss,avg_loss,training_accuracy,samples\n";  // CSV header
         std::cout << "Loss tracking enabled - saving to: " << loss_filename << std::endl;
     }
+    if (config.output.metrics_stream) {
+        std::cout << "Metrics stream enabled - saving to: " << metrics_filename << std::endl;
+    }
     
-    for (int epoch = 0; epoch < config.training.epochs; ++epoch) {
-        std::cout << "Epoch " << (epoch + 1) << "/" << config.training.epochs << ": \n";
+    ANN::Trainer trainer(network, config.training);
+    trainer.set_profiler(&profiler);
+
+    // Augmented copies are made per batch on their own threads as training streams through the set
+    std::unique_ptr<ANN::Augmenter> augmenter;
+    if (config.training.augmentation.enabled) {
+        augmenter = std::make_unique<ANN::Augmenter>(config.training.augmentation, config.data.image_size[0], config.data.image_size[1],
+                                                     config.data.normalize ? 1.0 : 255.0,
+                                                     resume_checkpoint ? resume_checkpoint->state.augment_seed : std::random_device{}());
+        trainer.set_augmenter(augmenter.get());
+        std::cout << "Augmentation enabled on " << config.training.augmentation.threads << " thread(s)" << std::endl;
+    }
 
-        if (config.training.shuffle) {
-            std::shuffle(instances.begin(), instances.end(), g);
-        }
-        
-        int samples_processed = 0;
-        double total_loss = 0.0;  // Track total loss for this epoch
-        int correct_predictions = 0;  // Track training accuracy
-        
-
-
-        for (const auto & instance : instances) {
-            double sample_loss = network.train(instance.input_data, instance.label, epoch);
-            total_loss += sample_loss;  // Accumulate loss
-            
-            // Calculate accuracy on this sample
-            int predicted_label = network.predict_label(instance.input_data);
-            if (predicted_label == instance.label) {
-                correct_predictions++;
+    // Distil from a trained teacher, its outputs for the training set are worked out once here
+    std::unique_ptr<ANN::TeacherCache> teacher_cache;
+    if (config.training.distillation.enabled) {
+        try {
+            ANN::Network teacher = ANN::Network::load(config.training.distillation.teacher);
+            if (teacher.input_size() != network.input_size()) {
+                throw std::runtime_error("Teacher network takes " + std::to_string(teacher.input_size()) + " inputs");
             }
-            
-            samples_processed++;
-
-            // Show progress every 100 samples for better performance
-            if (samples_processed % 100 == 0) {
-                double current_accuracy = (double)correct_predictions / samples_processed * 100.0;
-                std::cout << "Progress: " << samples_processed << "/" << instances.size() 
-                          << " Acc: " << std::fixed << std::setprecision(1) << current_accuracy << "% \r";
+            auto cache_start = std::chrono::steady_clock::now();
+            teacher_cache = std::make_unique<ANN::TeacherCache>(teacher, training_set, config.data.loader_threads);
+            trainer.set_teacher(teacher_cache.get());
+            std::cout << "Distilling from teacher " << config.training.distillation.teacher << " ("
+                      << teacher.layer_count() << " layers, " << teacher.parameters().size() << " parameters), outputs cached in "
+                      << std::fixed << std::setprecision(0) << elapsed_ms(cache_start) << "ms" << std::defaultfloat << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Error loading teacher: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Show progress every 100 samples for better performance
+    trainer.on_progress([&](int samples_processed, size_t total, double current_accuracy) {
+        metrics->progress(samples_processed, total, current_accuracy);
+    }, 100);
+
+    trainer.on_epoch_end([&](const ANN::EpochStats& stats) {
+        metrics->epoch(stats);
+
+        if (profile_file) {
+            profile_file->write_row("train", stats.epoch, profiler, stats.milliseconds);
+        }
+    });
+
+    // Checkpoints are copied at the step they are taken and written in the background
+    std::unique_ptr<ANN::AsyncCheckpointWriter> checkpoint_writer;
+    if (config.training.checkpoint.enabled) {
+        try {
+            checkpoint_writer = std::make_unique<ANN::AsyncCheckpointWriter>(config.training.checkpoint);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        trainer.on_checkpoint([&](const ANN::TrainingState& state) {
+            checkpoint_writer->submit(network, state);
+        }, config.training.checkpoint.interval);
+        std::cout << "Checkpoints enabled - saving to: " << config.training.checkpoint.directory << std::endl;
+    }
+    if (resume_checkpoint) {
+        trainer.restore(resume_checkpoint->state);
+    }
+
+    // First layer weight images, encoded to PNG in the background while training carries on
+    std::unique_ptr<ANN::Visualization::AsyncWeightSnapshots> weight_snapshots;
+    if (config.output.weight_snapshots > 0) {
+        weight_snapshots = std::make_unique<ANN::Visualization::AsyncWeightSnapshots>();
+        std::cout << "Weight snapshots every " << config.output.weight_snapshots << " epoch(s) - saving to: DigitRecog_Weights_"
+                  << run_tag << "_epoch_N.png" << std::endl;
+    }
+
+    // Each epoch's weights are scored on the validation set while the next epoch trains
+    std::unique_ptr<ANN::AsyncValidator> validator;
+    std::string checkpoint_filename = "DigitRecog_Best_" + run_tag + ".bin";
+    if (!validation_set.get_instances().empty()) {
+        validator = std::make_unique<ANN::AsyncValidator>(validation_set, config.training.early_stopping, config.evaluation.batch_size);
+        validator->set_checkpoint_file(checkpoint_filename);
+        validator->on_result([&](const ANN::ValidationStats& stats) {
+            metrics->validation(stats.epoch, stats.loss, stats.accuracy, stats.improved);
+        });
+    }
+
+    const int first_epoch = resume_checkpoint ? resume_checkpoint->state.epoch : 0;
+    for (int epoch = first_epoch; epoch < config.training.epochs; ++epoch) {
+        metrics->epoch_start(epoch + 1, config.training.epochs);
+        trainer.run_epoch(training_set, epoch);
+
+        if (weight_snapshots && (epoch + 1) % config.output.weight_snapshots == 0) {
+            weight_snapshots->submit(network.layer_at(0), "DigitRecog_Weights_" + run_tag + "_epoch_" + std::to_string(epoch + 1) + ".png",
+                                     config.data.image_size[0], config.data.image_size[1]);
+        }
+
+        if (validator) {
+            validator->submit(network, epoch + 1);
+            if (validator->should_stop()) {
+                metrics->flush();
+                std::cout << "Early stopping after epoch " << (epoch + 1) << ", validation loss stopped improving" << std::endl;
+                break;
             }
         }
-        
-        // Calculate statistics for this epoch
-        double avg_loss = total_loss / samples_processed;
-        double training_accuracy = (double)correct_predictions / samples_processed * 100.0;
-        
-        std::cout << "  Epoch " << (epoch + 1) << " completed: " << samples_processed << " samples"
-                  << " | Loss: " << std::fixed << std::setprecision(6) << avg_loss
-                  << " | Train Acc: " << std::fixed << std::setprecision(2) << training_accuracy << "%" << std::endl;
-
-        // Save loss data to CSV file
-        if (config.output.save_plots && loss_file.is_open()) {
-            loss_file << (epoch + 1) << "," << total_loss << "," << avg_loss << "," 
-                      << training_accuracy << "," << samples_processed << "\n";
-            loss_file.flush();  // Ensure data is written immediately
+    }
+
+    metrics->flush();
+
+    if (checkpoint_writer) {
+        checkpoint_writer->wait();
+        std::cout << "Checkpoints written: " << checkpoint_writer->written();
+        if (checkpoint_writer->superseded() > 0) {
+            std::cout << " (" << checkpoint_writer->superseded() << " superseded, writer fell behind)";
+        }
+        if (!checkpoint_writer->last_file().empty()) {
+            std::cout << ", last " << checkpoint_writer->last_file();
+        }
+        std::cout << std::endl;
+    }
+
+    if (weight_snapshots) {
+        weight_snapshots->wait();
+        std::cout << "Weight snapshots saved: " << weight_snapshots->written();
+        if (weight_snapshots->dropped() > 0) {
+            std::cout << " (" << weight_snapshots->dropped() << " dropped, encoder fell behind)";
         }
+        std::cout << std::endl;
+    }
 
-        //
-        // Output Loss Per Epoch
-        //
-        // double avg_loss = total_loss / samples_processed;
-        // loss_file << epoch << "," << total_loss << ", " << avg_loss << "," << accuracy << "\n";
+    if (validator) {
+        validator->wait();
+        metrics->flush();
+        const auto& best = validator->best_stats();
+        std::cout << "Best validation loss " << std::fixed << std::setprecision(6) << best.loss
+                  << " after epoch " << best.epoch << ", saved to: " << checkpoint_filename << std::endl;
+
+        // Carry on with the best weights rather than the last ones
+        if (config.training.early_stopping.enabled && validator->best_network()) {
+            network = *validator->best_network();
+            network.set_profiler(&profiler);
+            if (perf_counters && perf_counters->is_available()) {
+                network.set_perf_counters(perf_counters.get());
+            }
+            std::cout << "Restored weights from epoch " << best.epoch << std::endl;
+        }
     }
     
-    // Close loss file
-    if (loss_file.is_open()) {
-        loss_file.close();
+    // Write what is left and close the loss file
+    metrics->close();
+    if (config.output.save_plots) {
         std::cout << "Loss data saved to: " << loss_filename << std::endl;
     }
 
     std::cout << "Training completed!\n";
 
+    if (perf_counters && perf_counters->is_available()) {
+        // Only the training phases are of interest, stop counting before testing
+        network.set_perf_counters(nullptr);
+        perf_counters->print_report(std::cout);
+
+        std::string perf_filename = "DigitRecog_PerfCounters_" + run_tag + ".csv";
+        if (perf_counters->save_csv(perf_filename)) {
+            std::cout << "Hardware counter data saved to: " << perf_filename << std::endl;
+        }
+    }
+
     std::cout << " Time " << Utils::Time::HumanReadableTimeNowMillis() << std::endl << std::endl;
 
     std::cout << "\n\nTesting network on test data..." << std::endl;
 
-    int count = 0;
-    int correct = 0;
-    for (const auto& entry : std::filesystem::directory_iterator(config.data.test_path)) {
-        if (entry.is_regular_file()) {
-            if ( std::filesystem::path(entry).extension() == ".png" ) {
-                
-                std::string filename = std::filesystem::path(entry).filename().string();
-                int label = std::stoi(filename.substr(0, filename.find('_')));
-
-                std::vector<double> image_data = ANN::load_image(std::filesystem::path(entry).string());
-                
-                if (config.data.normalize && !image_data.empty()) {
-                    ANN::normalise_image(image_data, 255);
-                }
+    profiler.reset();
+    stage_start = std::chrono::steady_clock::now();
+
+    // Preload the whole test set, then score it batched across threads with one forward pass per image
+    ANN::TrainingSet test_set = ANN::load_training_set(config.data.test_path, config.data.normalize,
+                                                       &profiler, config.data.loader_threads);
+    // Training is over, drop the gradients and pre-activations only backpropagation needs.
+    // Optionally score from compact float16/bfloat16 weights, as an inference host would
+    network.set_inference_mode(true);
+    network.set_inference_precision(*ANN::parse_precision(config.network.inference_precision));
+    if (network.inference_precision() != ANN::Precision::Double) {
+        std::cout << "Inference precision " << ANN::precision_name(network.inference_precision()) << std::endl;
+    }
 
-                //
-                // test it 
-                //
-                int predicted = network.predict_label(image_data);
-                auto raw_outputs = network.predict_probabilities(image_data);
-                
-                std::cout << "File: " << filename << " label: " << label << " predicted: " << predicted;
-
-                count++;                
-                if ( predicted == label ) {
-                    std::cout << " correct\r";
-                    correct++;
-                } else {
-                    std::cout << " incorrect\r";
-                }
-            }
-        }
+    ANN::EvaluationResult evaluation;
+    {
+        ANN::Profiling::ScopedTimer timer(&profiler, ANN::Profiling::Phase::Evaluation);
+        evaluation = ANN::evaluate(network, test_set, config.evaluation.threads, config.evaluation.batch_size);
+    }
+
+    if (profile_file) {
+        profile_file->write_row("test", 0, profiler, elapsed_ms(stage_start));
+        std::cout << "Profile data saved to: " << profile_filename << std::endl;
     }
-    std::cout << std::endl;
 
     // Final accuracy summary
     std::cout << "\n=== FINAL RESULTS ===\n";
-    std::cout << "Total tested: " << count << " images\n";
-    std::cout << "Correct predictions: " << correct << "\n";
-    double final_accuracy = (static_cast<double>(correct) / static_cast<double>(count)) * 100.0;
-    std::cout << "Final accuracy: " << std::fixed << std::setprecision(2) << final_accuracy << "%\n";
+    evaluation.print(std::cout);
     std::cout << "Time " << Utils::Time::HumanReadableTimeNowMillis() << std::endl << std::endl;
 
+    std::string confusion_filename = "DigitRecog_Confusion_" + run_tag + ".csv";
+    if (evaluation.save_csv(confusion_filename)) {
+        std::cout << "Confusion matrix saved to: " << confusion_filename << std::endl;
+    }
+
     // Save config and results to txt file
     std::ofstream txt_file(txt_filename);
     if (txt_file.is_open()) {
@@ -251,21 +666,46 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
         }
         txt_file << "\nActivation: " << config.network.activation << "\n";
         txt_file << "Weight Init: " << config.network.weight_init.method << " [" << config.network.weight_init.range[0] << ", " << config.network.weight_init.range[1] << "]\n";
+        txt_file << "Weight Seed: " << network.weight_seed() << "\n";
+        txt_file << "Inference Precision: " << config.network.inference_precision << "\n";
+        txt_file << "Activation Kernel: " << config.network.activation_kernel << "\n";
         txt_file << "Training Epochs: " << config.training.epochs << "\n";
         txt_file << "Learning Rate Schedule: " << config.training.learning_rate.schedule << "\n";
         txt_file << "Learning Rate Initial: " << config.training.learning_rate.initial << "\n";
         txt_file << "Learning Rate Decay: " << config.training.learning_rate.decay << "\n";
         txt_file << "Learning Rate Min: " << config.training.learning_rate.min << "\n";
         txt_file << "Learning Rate Step: " << config.training.learning_rate.step << "\n";
+        txt_file << "Learning Rate Gamma: " << config.training.learning_rate.gamma << "\n";
+        txt_file << "Learning Rate Warmup Epochs: " << config.training.learning_rate.warmup_epochs << "\n";
+        txt_file << "Learning Rate Update: " << config.training.learning_rate.update << "\n";
+        txt_file << "Fused Update: " << (config.training.fused_update ? "true" : "false") << "\n";
         txt_file << "Shuffle: " << (config.training.shuffle ? "true" : "false") << "\n";
+        txt_file << "Validation Split: " << config.training.validation_split << "\n";
+        txt_file << "Early Stopping: " << (config.training.early_stopping.enabled ? "true" : "false")
+                 << " (patience " << config.training.early_stopping.patience << ")\n";
+        txt_file << "Augmentation: " << (config.training.augmentation.enabled ? "true" : "false");
+        if (config.training.augmentation.enabled) {
+            txt_file << " (shift " << config.training.augmentation.shift << ", rotation " << config.training.augmentation.rotation
+                     << ", scale " << config.training.augmentation.scale << ", elastic " << config.training.augmentation.elastic_alpha
+                     << "/" << config.training.augmentation.elastic_sigma << ", noise " << config.training.augmentation.noise << ")";
+        }
+        txt_file << "\n";
+        txt_file << "Distillation: " << (config.training.distillation.enabled ? "true" : "false");
+        if (config.training.distillation.enabled) {
+            txt_file << " (teacher " << config.training.distillation.teacher << ", temperature " << config.training.distillation.temperature
+                     << ", alpha " << config.training.distillation.alpha << ")";
+        }
+        txt_file << "\n";
         txt_file << "Train Path: " << config.data.train_path << "\n";
         txt_file << "Test Path: " << config.data.test_path << "\n";
         txt_file << "Image Size: " << config.data.image_size[0] << "x" << config.data.image_size[1] << "\n";
         txt_file << "Normalize: " << (config.data.normalize ? "true" : "false") << "\n";
+        txt_file << "Weight Snapshots: " << config.output.weight_snapshots << " epoch interval\n";
         txt_file << "\n=== FINAL RESULTS ===\n";
-        txt_file << "Total tested: " << count << " images\n";
-        txt_file << "Correct predictions: " << correct << "\n";
-        txt_file << "Final accuracy: " << std::fixed << std::setprecision(2) << final_accuracy << "%\n";
+        txt_file << "Total tested: " << evaluation.total << " images\n";
+        txt_file << "Correct predictions: " << evaluation.correct << "\n";
+        txt_file << "Final accuracy: " << std::fixed << std::setprecision(2) << evaluation.accuracy() << "%\n\n";
+        evaluation.print(txt_file);
         txt_file.close();
         std::cout << "Config and results saved to: " << txt_filename << std::endl;
     } else {